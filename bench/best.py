@@ -0,0 +1,11 @@
+# best wall time of `runs` runs of a command, and the peak RSS over them, stdout discarded
+# usage: best.py runs command [args...]
+import sys, subprocess, time, resource
+
+best = None
+for _ in range(int(sys.argv[1])):
+    t = time.time()
+    subprocess.run(sys.argv[2:], stdout=subprocess.DEVNULL)
+    d = time.time() - t
+    best = d if best is None else min(best, d)
+print("best %.3fs maxrss %d KB" % (best, resource.getrusage(resource.RUSAGE_CHILDREN).ru_maxrss))
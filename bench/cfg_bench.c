@@ -0,0 +1,118 @@
+// CFG build, dominators and loop nesting over every function of one input, with -check also
+// compared against a naive set-based dominator computation
+// usage: cfg_bench [-check] input.cmm
+#include "cfg.h"
+#include <time.h>
+
+extern int yyparse();
+extern void yyrestart(FILE*);
+extern pNode root;
+
+int lexError = 0;
+int synError = 0;
+
+static double now() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+// dom[x * n + y]: y dominates x, iterated to the fixpoint over the reachable blocks
+static boolean checkCfg(pCfg p) {
+    int n = p->blockNum;
+    char* dom = (char*)calloc((size_t)n * n, 1);
+    assert(dom != NULL);
+    for (int x = 0; x < n; x++)
+        for (int y = 0; y < n; y++)
+            dom[x * n + y] = p->blocks[x].rpo >= 0 && (p->blocks[x].rpo == 0 ? x == y : 1);
+    boolean changed = TRUE;
+    while (changed) {
+        changed = FALSE;
+        for (int k = 1; k < p->orderNum; k++) {
+            int x = p->order[k];
+            pBasicBlock b = &p->blocks[x];
+            for (int y = 0; y < n; y++) {
+                int v = x == y;
+                if (!v) {
+                    int any = 0;
+                    v = 1;
+                    for (int j = 0; j < b->predNum; j++) {
+                        int pred = b->preds[j];
+                        if (p->blocks[pred].rpo < 0) continue;
+                        any = 1;
+                        if (!dom[pred * n + y]) {
+                            v = 0;
+                            break;
+                        }
+                    }
+                    if (!any) v = 0;
+                }
+                if (dom[x * n + y] != v) {
+                    dom[x * n + y] = v;
+                    changed = TRUE;
+                }
+            }
+        }
+    }
+    boolean ok = TRUE;
+    for (int x = 0; x < n && ok; x++)
+        for (int y = 0; y < n && ok; y++)
+            if (p->blocks[x].rpo >= 0 && (dom[x * n + y] != 0) != (dominates(p, y, x) != 0))
+                ok = FALSE;
+    for (int k = 0; k < p->loopNum && ok; k++) {
+        pLoop loop = &p->loops[k];
+        for (int j = 0; j < loop->blockNum; j++)
+            if (!dominates(p, loop->header, loop->blocks[j]))
+                ok = FALSE;
+    }
+    free(dom);
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    boolean check = argc > 2 && !strcmp(argv[1], "-check");
+    if (argc < 2) {
+        fprintf(stderr, "usage: cfg_bench [-check] input.cmm\n");
+        return 1;
+    }
+    FILE* fr = fopen(argv[argc - 1], "r");
+    if (fr == NULL) {
+        perror(argv[argc - 1]);
+        return 1;
+    }
+    nodeArena = newArena(ARENA_BLOCK_SIZE);
+    yyrestart(fr);
+    yyparse();
+    table = initTable();
+    traverseTree(root);
+    interCodeList = newInterCodeList();
+    genInterCodes(root);
+
+    pInterCodeList l = interCodeList;
+    long blocks = 0, loops = 0;
+    double build = 0, doms = 0, nesting = 0;
+    for (int i = 0; i < l->count; ) {
+        int last = getFunctionEnd(l, i);
+        double t0 = now();
+        pCfg p = newCfg(l, i, last);
+        double t1 = now();
+        computeDominators(p);
+        double t2 = now();
+        computeLoops(p);
+        double t3 = now();
+        build += t1 - t0;
+        doms += t2 - t1;
+        nesting += t3 - t2;
+        blocks += p->blockNum;
+        loops += p->loopNum;
+        if (check && !checkCfg(p)) {
+            printf("function at code %d: dominators or loops disagree with the naive computation\n", i);
+            return 1;
+        }
+        deleteCfg(p);
+        i = last;
+    }
+    printf("%d codes, %ld blocks, %ld loops: build %.3fs, dominators %.3fs, loops %.3fs\n",
+           l->count, blocks, loops, build, doms, nesting);
+    return 0;
+}
@@ -0,0 +1,45 @@
+# n functions of straight-line arithmetic over params, locals, an array and a struct, six
+# expressions of depth `depth` each, plus a main calling the first 50
+# usage: gen_big.py n [depth] > out.cmm    (big.cmm: 3000, exprheavy.cmm: 400 7)
+import sys, random, re
+random.seed(1)
+n = int(sys.argv[1])
+depth = int(sys.argv[2]) if len(sys.argv) > 2 else 4
+out = []
+out.append("struct Pt { int x; int y; };")
+def expr(d):
+    if d == 0:
+        return random.choice(["a%d", "b%d", "c%d", str(random.randint(0, 9)), "v%d[2]", "p%d.x"]).replace("%d", str(cur[0]))
+    op = random.choice(["+", "-", "*", "+", "-"])
+    return "(" + expr(d-1) + " " + op + " " + expr(d-1) + ")"
+cur = [0]
+for i in range(n):
+    cur[0] = i
+    out.append("int f%d(int a%d, int b%d)" % (i, i, i))
+    out.append("{")
+    body = """    int c, i;
+    int v[10];
+    struct Pt p;
+    i = 0; c = a; p.x = b;
+    while (i < 10) {
+        v[i] = i * 2 + a;
+        i = i + 1;
+    }
+"""
+    for k in range(6):
+        body += "    c = %s;\n" % expr(depth)
+        body += "    if (c > a && b < c || !(a == b)) c = c - 1; else c = c + 1;\n"
+    body += "    return c;"
+    body = re.sub(r"\b([abcivp])\b", lambda m: m.group(1) + str(i), body)
+    out.append(body)
+    out.append("}")
+out.append("int main()")
+out.append("{")
+out.append("    int r;")
+out.append("    r = read();")
+for i in range(min(n, 50)):
+    out.append("    r = r + f%d(r, %d);" % (i, i))
+out.append("    write(r);")
+out.append("    return 0;")
+out.append("}")
+print("\n".join(out))
@@ -0,0 +1,25 @@
+# one main of nested whiles and ifs around arithmetic, n statements
+# usage: gen_func.py n > out.cmm
+import sys, random
+random.seed(5)
+n = int(sys.argv[1])
+out = ["int main()", "{", "int x, y, z, i0, i1, i2, i3;", "x = read(); y = 1; z = 2;"]
+def block(depth, budget):
+    s = []
+    while budget > 0:
+        r = random.random()
+        if depth < 4 and r < 0.25:
+            iv = "i%d" % depth
+            s.append("%s = 0;" % iv); s.append("while (%s < 3) {" % iv)
+            k = random.randint(1, min(budget, 20)); s += block(depth + 1, k); budget -= k
+            s.append("%s = %s + 1;" % (iv, iv)); s.append("}")
+        elif depth < 6 and r < 0.5:
+            s.append("if (x > y && z < %d || y == z) {" % random.randint(0, 9))
+            k = random.randint(1, min(budget, 10)); s += block(depth + 1, k); budget -= k
+            s.append("} else {"); s.append("z = z - x;"); s.append("}")
+        else:
+            s.append("x = x + y * z - %d;" % random.randint(0, 9)); budget -= 1
+    return s
+out += block(0, n)
+out += ["write(x);", "return 0;", "}"]
+print("\n".join(out))
@@ -0,0 +1,72 @@
+# random well-typed program with functions, arrays, structs, loops and calls, for differential tests
+# usage: gen_rand.py seed > out.cmm
+import sys, random
+seed = int(sys.argv[1]); random.seed(seed)
+NF = random.randint(1, 4)
+out = ["struct S { int a; int b; };"]
+def cnst(): return str(random.choice([0, 1, 2, 3, 4, 5, 7, 10, 100]))
+def expr(k, d, allow_call):
+    vs = ["v%d_%d" % (k, i) for i in range(3)] + ["p%d_%d" % (k, i) for i in range(2)]
+    r = random.random()
+    if d == 0 or r < 0.25:
+        c = random.random()
+        if c < 0.45: return random.choice(vs)
+        if c < 0.7: return cnst()
+        if c < 0.85: return "a%d[%d]" % (k, random.randint(0, 7))
+        return "s%d.%s" % (k, random.choice("ab"))
+    if allow_call and k > 0 and r < 0.33:
+        j = random.randint(0, k - 1)
+        return "f%d(%s, %s)" % (j, expr(k, d - 1, False), expr(k, d - 1, False))
+    if r < 0.4: return "(-%s)" % expr(k, d - 1, allow_call)
+    if r < 0.5: return "(%s / %s)" % (expr(k, d - 1, allow_call), random.choice(["2", "3", "7"]))
+    op = random.choice(["+", "-", "*", "+", "-"])
+    return "(%s %s %s)" % (expr(k, d - 1, allow_call), op, expr(k, d - 1, allow_call))
+def cond(k, d):
+    r = random.random()
+    if d > 0 and r < 0.2: return "(%s && %s)" % (cond(k, d - 1), cond(k, d - 1))
+    if d > 0 and r < 0.35: return "(%s || %s)" % (cond(k, d - 1), cond(k, d - 1))
+    if d > 0 and r < 0.45: return "!(%s)" % cond(k, d - 1)
+    return "%s %s %s" % (expr(k, 1, False), random.choice(["<", ">", "==", "!=", "<=", ">="]), expr(k, 1, False))
+def stmts(k, depth, n, loopvars):
+    s = []
+    for _ in range(n):
+        r = random.random()
+        tgt = random.choice(["v%d_%d" % (k, i) for i in range(3)] + ["a%d[%d]" % (k, random.randint(0, 7)), "s%d.a" % k, "s%d.b" % k])
+        if r < 0.4 or depth >= 3:
+            s.append("%s = %s;" % (tgt, expr(k, 3, depth == 0)))
+        elif r < 0.55 and loopvars:
+            lv = loopvars[0]
+            s.append("a%d[%s] = %s;" % (k, lv, expr(k, 2, False)))
+        elif r < 0.7:
+            s.append("if (%s) {" % cond(k, 2)); s += stmts(k, depth + 1, random.randint(1, 3), loopvars)
+            if random.random() < 0.6:
+                s.append("} else {"); s += stmts(k, depth + 1, random.randint(1, 3), loopvars)
+            s.append("}")
+        elif r < 0.85 and len(loopvars) < 2:
+            lv = "c%d_%d" % (k, 2 - len(loopvars) - 1)
+            s.append("%s = 0;" % lv)
+            s.append("while (%s < %d) {" % (lv, random.randint(1, 8)))
+            s += stmts(k, depth + 1, random.randint(1, 3), [lv] + loopvars)
+            s.append("%s = %s + 1;" % (lv, lv)); s.append("}")
+        else:
+            s.append("write(%s);" % expr(k, 2, False))
+    return s
+for k in range(NF + 1):
+    name = "main" if k == NF else "f%d" % k
+    if k == NF: out.append("int main()")
+    else: out.append("int f%d(int p%d_0, int p%d_1)" % (k, k, k))
+    out.append("{")
+    out.append("int v%d_0, v%d_1, v%d_2, c%d_0, c%d_1;" % ((k,) * 5))
+    if k == NF: out.append("int p%d_0, p%d_1;" % (k, k))
+    out.append("int a%d[8];" % k)
+    out.append("struct S s%d;" % k)
+    if k == NF: out.append("p%d_0 = read(); p%d_1 = read();" % (k, k))
+    out.append("v%d_0 = %s; v%d_1 = %s; v%d_2 = %s; s%d.a = 1; s%d.b = 2;" % (k, cnst(), k, cnst(), k, cnst(), k, k))
+    out.append("c%d_0 = 0; while (c%d_0 < 8) { a%d[c%d_0] = c%d_0; c%d_0 = c%d_0 + 1; }" % ((k,) * 7))
+    out += stmts(k, 0, random.randint(3, 8), [])
+    if k == NF:
+        for j in range(NF): out.append("write(f%d(v%d_0, p%d_1));" % (j, k, k))
+    out.append("write(v%d_0 + v%d_1 + v%d_2 + a%d[3] + s%d.a);" % ((k,) * 5))
+    out.append("return %s;" % expr(k, 1, False))
+    out.append("}")
+print("\n".join(out))
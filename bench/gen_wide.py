@@ -0,0 +1,21 @@
+# n functions, each looping over accesses to the back half of two locals of one nf-field struct
+# usage: gen_wide.py n nf > out.cmm
+import sys
+n = int(sys.argv[1]); nf = int(sys.argv[2])
+out = ["struct W {"] + ["    int f%d;" % i for i in range(nf)] + ["};"]
+for i in range(n):
+    out.append("int g%d(int a)" % i)
+    out.append("{")
+    out.append("    struct W s%d; struct W u%d; int i;" % (i, i))
+    out.append("    i = 0;")
+    out.append("    while (i < a) {")
+    for j in range(40):
+        f = nf - 1 - (j * 3) % (nf // 2)
+        out.append("        s%d.f%d = s%d.f%d + u%d.f%d + i;" % (i, f, i, nf - 1 - j, i, f))
+    out.append("        u%d.f0 = u%d.f0 + s%d.f%d;" % (i, i, i, nf - 1))
+    out.append("        i = i + 1;")
+    out.append("    }")
+    out.append("    return u%d.f0;" % i)
+    out.append("}")
+out += ["int main()", "{", "    write(g0(read()));", "    return 0;", "}"]
+print("\n".join(out))
@@ -0,0 +1,36 @@
+// symbol table microbenchmark: insert N distinct names at depth 0, then look each up 4 times in a
+// scattered order, for N = 1K, 10K, 100K and 1M
+#include "semantic.h"
+#include <time.h>
+
+static double now() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+int main() {
+    int sizes[] = {1000, 10000, 100000, 1000000};
+    for (int k = 0; k < 4; k++) {
+        int n = sizes[k];
+        table = initTable();
+        char buf[32];
+        char** names = (char**)malloc(sizeof(char*) * n);
+        for (int i = 0; i < n; i++) {
+            sprintf(buf, "var_%d", i);
+            names[i] = newString(buf);
+        }
+        double t0 = now();
+        for (int i = 0; i < n; i++)
+            addTableItem(table, newItem(0, newFieldList(names[i], NULL)));
+        double t1 = now();
+        long found = 0;
+        for (int r = 0; r < 4; r++)
+            for (int i = 0; i < n; i++)
+                found += searchTableItem(table, names[(i * 7919L) % n]) != NULL;
+        double t2 = now();
+        printf("%8d symbols: insert %7.1f Mops/s  lookup %7.1f Mops/s (%ld found)\n",
+               n, n / (t1 - t0) / 1e6, 4.0 * n / (t2 - t1) / 1e6, found);
+    }
+    return 0;
+}
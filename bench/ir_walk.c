@@ -0,0 +1,77 @@
+// IR container cost on one input: a read-only pass over every code that looks at the kind of its
+// first operand, then printInterCode to /dev/null, best of 5 each
+// usage: ir_walk input.cmm
+#include "inter.h"
+#include "syntax.tab.h"
+#include <time.h>
+
+extern int yyparse();
+extern void yyrestart(FILE*);
+extern pNode root;
+
+int lexError = 0;
+int synError = 0;
+
+static double now() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+// INTER_CODE_INIT_SIZE comes with the code array, older trees keep codes in a linked list
+static long walk(pInterCodeList l, long* codeNum) {
+    long constants = 0;
+    *codeNum = 0;
+#ifdef INTER_CODE_INIT_SIZE
+    for (int i = 0; i < l->count; i++) {
+        int op = l->codes[i].u.oneOp.op;
+        if (op != 0 && getOperand(l, op)->kind == OP_CONSTANT)
+            constants++;
+        (*codeNum)++;
+    }
+#else
+    for (pInterCodes cur = l->head; cur != NULL; cur = cur->next) {
+        pOperand op = cur->code->u.oneOp.op;
+        if (op != NULL && op->kind == OP_CONSTANT)
+            constants++;
+        (*codeNum)++;
+    }
+#endif
+    return constants;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: ir_walk input.cmm\n");
+        return 1;
+    }
+    FILE* fr = fopen(argv[1], "r");
+    if (fr == NULL) {
+        perror(argv[1]);
+        return 1;
+    }
+    nodeArena = newArena(ARENA_BLOCK_SIZE);
+    yyrestart(fr);
+    yyparse();
+    table = initTable();
+    traverseTree(root);
+    interCodeList = newInterCodeList();
+    genInterCodes(root);
+
+    long codeNum = 0, constants = 0;
+    double bestWalk = 1e9, bestPrint = 1e9;
+    for (int r = 0; r < 5; r++) {
+        double t0 = now();
+        constants = walk(interCodeList, &codeNum);
+        double t1 = now();
+        FILE* fw = fopen("/dev/null", "w");
+        printInterCode(fw, interCodeList);
+        fclose(fw);
+        double t2 = now();
+        if (t1 - t0 < bestWalk) bestWalk = t1 - t0;
+        if (t2 - t1 < bestPrint) bestPrint = t2 - t1;
+    }
+    printf("%ld codes (%ld constant first operands): walk %.1f ns/code, printInterCode %.3fs\n",
+           codeNum, constants, bestWalk / codeNum * 1e9, bestPrint);
+    return 0;
+}
@@ -0,0 +1,67 @@
+// semantic pass on one input: heap allocations of one run and wall time, best of 3, each run on a
+// fresh symbol table over the same tree; malloc, calloc and realloc are counted through -Wl,--wrap
+// usage: sem_bench input.cmm
+#include "semantic.h"
+#include "syntax.tab.h"
+#include <time.h>
+
+extern int yyparse();
+extern void yyrestart(FILE*);
+extern pNode root;
+
+int lexError = 0;
+int synError = 0;
+
+static long allocs = 0;
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t num, size_t size);
+void* __real_realloc(void* p, size_t size);
+
+void* __wrap_malloc(size_t size) { allocs++; return __real_malloc(size); }
+void* __wrap_calloc(size_t num, size_t size) { allocs++; return __real_calloc(num, size); }
+void* __wrap_realloc(void* p, size_t size) { allocs++; return __real_realloc(p, size); }
+
+static double now() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+static long countExps(pNode node) {
+    long n = 0;
+    for (; node != NULL; node = node->sibling)
+        n += (node->name == N_Exp) + countExps(node->child);
+    return n;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: sem_bench input.cmm\n");
+        return 1;
+    }
+    FILE* fr = fopen(argv[1], "r");
+    if (fr == NULL) {
+        perror(argv[1]);
+        return 1;
+    }
+    nodeArena = newArena(ARENA_BLOCK_SIZE);
+    yyrestart(fr);
+    yyparse();
+    if (lexError || synError) return 1;
+
+    long runAllocs = 0;
+    double best = 1e9;
+    for (int r = 0; r < 3; r++) {
+        table = initTable();
+        long before = allocs;
+        double t0 = now();
+        traverseTree(root);
+        double t1 = now();
+        runAllocs = allocs - before;
+        if (t1 - t0 < best) best = t1 - t0;
+    }
+    printf("%ld Exp nodes: semantic pass %.1f ms, %ld allocations\n", countExps(root), best * 1e3,
+           runAllocs);
+    return 0;
+}
@@ -0,0 +1,42 @@
+// per-compilation fixed cost: parse, check, translate and emit "int main() { return 0; }" 10,000
+// times in one process
+#include "inter.h"
+#include "syntax.tab.h"
+#include <time.h>
+
+extern int yyparse();
+extern void yyrestart(FILE*);
+extern pNode root;
+
+int lexError = 0;
+int synError = 0;
+
+static double now() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+int main() {
+    static char src[] = "int main()\n{\n    return 0;\n}\n";
+    FILE* fw = fopen("/dev/null", "w");
+    double t0 = now();
+    for (int i = 0; i < 10000; i++) {
+        FILE* fr = fmemopen(src, strlen(src), "r");
+        nodeArena = newArena(ARENA_BLOCK_SIZE);
+        yyrestart(fr);
+        yyparse();
+        table = initTable();
+        traverseTree(root);
+        interCodeList = newInterCodeList();
+        genInterCodes(root);
+        printInterCode(fw, interCodeList);
+        deleteInterCodeList(interCodeList);
+        deleteTable(table);
+        deleteArena(nodeArena);
+        fclose(fr);
+    }
+    double t = now() - t0;
+    printf("10000 compiles: %.3fs (%.1f us each)\n", t, t * 100);
+    return 0;
+}
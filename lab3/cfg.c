@@ -0,0 +1,511 @@
+#include "cfg.h"
+
+// Cfg func
+int getFunctionEnd(pInterCodeList interCodeList, int first) {
+    int i = first + 1;
+    while (i < interCodeList->count && interCodeList->codes[i].kind != IR_FUNCTION)
+        i++;
+    return i;
+}
+
+static boolean endsBlock(int kind) {
+    return kind == IR_GOTO || kind == IR_IF_GOTO || kind == IR_RETURN;
+}
+
+static void computeOrder(pCfg p) {
+    int* stack = (int*)malloc(sizeof(int) * p->blockNum);
+    int* next = (int*)calloc(p->blockNum, sizeof(int));
+    assert(stack != NULL && next != NULL);
+    for (int i = 0; i < p->blockNum; i++)
+        p->blocks[i].rpo = -1;
+
+    // iterative DFS, blocks are pushed to order in postorder and reversed afterwards
+    int top = 0, num = 0;
+    stack[top++] = 0;
+    p->blocks[0].rpo = 0;
+    while (top > 0) {
+        pBasicBlock b = &p->blocks[stack[top - 1]];
+        if (next[stack[top - 1]] < b->succNum) {
+            int s = b->succ[next[stack[top - 1]]++];
+            if (p->blocks[s].rpo < 0) {
+                p->blocks[s].rpo = 0;
+                stack[top++] = s;
+            }
+        }
+        else
+            p->order[num++] = stack[--top];
+    }
+    p->orderNum = num;
+    for (int i = 0; i < num / 2; i++) {
+        int t = p->order[i];
+        p->order[i] = p->order[num - 1 - i];
+        p->order[num - 1 - i] = t;
+    }
+    for (int i = 0; i < num; i++)
+        p->blocks[p->order[i]].rpo = i;
+    free(stack);
+    free(next);
+}
+
+pCfg newCfg(pInterCodeList interCodeList, int first, int last) {
+    assert(first < last && interCodeList->codes[first].kind == IR_FUNCTION);
+    pCfg p = (pCfg)malloc(sizeof(Cfg));
+    assert(p != NULL);
+    p->list = interCodeList;
+    p->first = first;
+    p->last = last;
+    p->loops = NULL;
+    p->loopNum = 0;
+    p->blockOf = (int*)malloc(sizeof(int) * (last - first));
+    assert(p->blockOf != NULL);
+
+    // a block starts at the function, at a label not directly after another label and after a jump
+    pInterCode codes = interCodeList->codes;
+    int blockNum = 0;
+    for (int i = first; i < last; i++) {
+        if (i == first || endsBlock(codes[i - 1].kind) ||
+            (codes[i].kind == IR_LABEL && codes[i - 1].kind != IR_LABEL))
+            blockNum++;
+        p->blockOf[i - first] = blockNum - 1;
+    }
+    p->blockNum = blockNum;
+    p->blocks = (pBasicBlock)calloc(blockNum, sizeof(BasicBlock));
+    p->order = (int*)malloc(sizeof(int) * blockNum);
+    assert(p->blocks != NULL && p->order != NULL);
+    for (int i = last - 1; i >= first; i--)
+        p->blocks[p->blockOf[i - first]].first = i;
+    for (int i = 0; i < blockNum; i++)
+        p->blocks[i].last = i + 1 < blockNum ? p->blocks[i + 1].first : last;
+
+    int* labelBlock = (int*)malloc(sizeof(int) * interCodeList->labelNum);
+    assert(labelBlock != NULL);
+    for (int i = 0; i < interCodeList->labelNum; i++)
+        labelBlock[i] = -1;
+    for (int i = first; i < last; i++)
+        if (codes[i].kind == IR_LABEL) {
+            int no = getOperand(interCodeList, codes[i].u.oneOp.op)->no;
+            assert(no > 0 && no < interCodeList->labelNum);
+            labelBlock[no] = p->blockOf[i - first];
+        }
+
+    int edgeNum = 0;
+    for (int i = 0; i < blockNum; i++) {
+        pBasicBlock b = &p->blocks[i];
+        pInterCode end = &codes[b->last - 1];
+        b->succNum = 0;
+        b->idom = -1;
+        b->loop = -1;
+        if (end->kind != IR_GOTO && end->kind != IR_RETURN && i + 1 < blockNum)
+            b->succ[b->succNum++] = i + 1;
+        if (end->kind == IR_GOTO || end->kind == IR_IF_GOTO) {
+            int label = end->kind == IR_GOTO ? end->u.oneOp.op : end->u.ifGoto.z;
+            int target = labelBlock[getOperand(interCodeList, label)->no];
+            assert(target >= 0 && target < blockNum && codes[p->blocks[target].first].kind == IR_LABEL);
+            if (b->succNum == 0 || b->succ[0] != target)
+                b->succ[b->succNum++] = target;
+        }
+        edgeNum += b->succNum;
+    }
+    free(labelBlock);
+
+    // predecessors are laid out block by block in one pool
+    p->predPool = (int*)malloc(sizeof(int) * (edgeNum > 0 ? edgeNum : 1));
+    assert(p->predPool != NULL);
+    for (int i = 0; i < blockNum; i++)
+        for (int j = 0; j < p->blocks[i].succNum; j++)
+            p->blocks[p->blocks[i].succ[j]].predNum++;
+    for (int i = 0, n = 0; i < blockNum; i++) {
+        p->blocks[i].preds = p->predPool + n;
+        n += p->blocks[i].predNum;
+        p->blocks[i].predNum = 0;
+    }
+    for (int i = 0; i < blockNum; i++)
+        for (int j = 0; j < p->blocks[i].succNum; j++) {
+            pBasicBlock s = &p->blocks[p->blocks[i].succ[j]];
+            s->preds[s->predNum++] = i;
+        }
+
+    computeOrder(p);
+    return p;
+}
+
+void deleteCfg(pCfg p) {
+    assert(p != NULL);
+    for (int i = 0; i < p->loopNum; i++)
+        free(p->loops[i].blocks);
+    free(p->loops);
+    free(p->blocks);
+    free(p->blockOf);
+    free(p->predPool);
+    free(p->order);
+    free(p);
+}
+
+// analysis func
+static int intersect(pCfg p, int a, int b) {
+    while (a != b) {
+        while (p->blocks[a].rpo > p->blocks[b].rpo) a = p->blocks[a].idom;
+        while (p->blocks[b].rpo > p->blocks[a].rpo) b = p->blocks[b].idom;
+    }
+    return a;
+}
+
+// Cooper, Harvey and Kennedy's iterative algorithm over the reverse postorder
+void computeDominators(pCfg p) {
+    for (int i = 0; i < p->blockNum; i++)
+        p->blocks[i].idom = -1;
+    p->blocks[0].idom = 0;
+    boolean changed = TRUE;
+    while (changed) {
+        changed = FALSE;
+        for (int i = 1; i < p->orderNum; i++) {
+            pBasicBlock b = &p->blocks[p->order[i]];
+            int idom = -1;
+            for (int j = 0; j < b->predNum; j++) {
+                int pred = b->preds[j];
+                if (p->blocks[pred].idom < 0) continue;
+                idom = idom < 0 ? pred : intersect(p, pred, idom);
+            }
+            if (b->idom != idom) {
+                b->idom = idom;
+                changed = TRUE;
+            }
+        }
+    }
+    p->blocks[0].idom = -1;
+
+    // number the dominator tree so that dominates() is two comparisons
+    int* childNum = (int*)calloc(p->blockNum + 1, sizeof(int));
+    int* children = (int*)malloc(sizeof(int) * p->blockNum);
+    int* stack = (int*)malloc(sizeof(int) * p->blockNum);
+    int* next = (int*)malloc(sizeof(int) * p->blockNum);
+    assert(childNum != NULL && children != NULL && stack != NULL && next != NULL);
+    for (int i = 0; i < p->orderNum; i++)
+        if (p->blocks[p->order[i]].idom >= 0) childNum[p->blocks[p->order[i]].idom + 1]++;
+    for (int i = 0; i < p->blockNum; i++)
+        childNum[i + 1] += childNum[i];
+    for (int i = 0; i < p->blockNum; i++)
+        next[i] = childNum[i];
+    for (int i = 0; i < p->orderNum; i++) {
+        int b = p->order[i];
+        if (p->blocks[b].idom >= 0) children[next[p->blocks[b].idom]++] = b;
+    }
+    for (int i = 0; i < p->blockNum; i++)
+        next[i] = childNum[i];
+    int top = 0, clock = 0;
+    stack[top++] = 0;
+    p->blocks[0].domPre = clock++;
+    while (top > 0) {
+        int b = stack[top - 1];
+        if (next[b] < childNum[b + 1]) {
+            int c = children[next[b]++];
+            p->blocks[c].domPre = clock++;
+            stack[top++] = c;
+        }
+        else {
+            p->blocks[b].domPost = clock++;
+            top--;
+        }
+    }
+    free(childNum);
+    free(children);
+    free(stack);
+    free(next);
+}
+
+static int compareLoopSize(const void* a, const void* b) {
+    return ((pLoop)b)->blockNum - ((pLoop)a)->blockNum;
+}
+
+// natural loops of the back edges b -> h with h dominating b, back edges sharing a header make one loop
+void computeLoops(pCfg p) {
+    for (int i = 0; i < p->loopNum; i++)
+        free(p->loops[i].blocks);
+    free(p->loops);
+    p->loops = NULL;
+    p->loopNum = 0;
+    int loopCap = 0;
+    int* mark = (int*)malloc(sizeof(int) * p->blockNum);
+    int* work = (int*)malloc(sizeof(int) * p->blockNum);
+    assert(mark != NULL && work != NULL);
+    for (int i = 0; i < p->blockNum; i++) {
+        mark[i] = -1;
+        p->blocks[i].loop = -1;
+        p->blocks[i].loopDepth = 0;
+    }
+
+    for (int i = 0; i < p->orderNum; i++) {
+        int h = p->order[i];
+        pBasicBlock header = &p->blocks[h];
+        int top = 0;
+        for (int j = 0; j < header->predNum; j++) {
+            int b = header->preds[j];
+            if (dominates(p, h, b) && mark[b] != h) {
+                mark[b] = h;
+                work[top++] = b;
+            }
+        }
+        if (top == 0) continue;
+
+        // walk backwards from the latches, the header stops the walk
+        int* blocks = (int*)malloc(sizeof(int) * p->blockNum);
+        assert(blocks != NULL);
+        int num = 0;
+        blocks[num++] = h;
+        mark[h] = h;
+        while (top > 0) {
+            int b = work[--top];
+            if (b == h) continue;
+            blocks[num++] = b;
+            for (int j = 0; j < p->blocks[b].predNum; j++) {
+                int pred = p->blocks[b].preds[j];
+                if (mark[pred] != h && p->blocks[pred].rpo >= 0) {
+                    mark[pred] = h;
+                    work[top++] = pred;
+                }
+            }
+        }
+        if (p->loopNum == loopCap) {
+            loopCap = loopCap ? loopCap * 2 : 4;
+            p->loops = (pLoop)realloc(p->loops, sizeof(Loop) * loopCap);
+            assert(p->loops != NULL);
+        }
+        p->loops[p->loopNum++] = (Loop){h, (int*)realloc(blocks, sizeof(int) * num), num, -1, 0};
+    }
+
+    // larger loops first, so inner loops overwrite the innermost loop of their blocks later
+    qsort(p->loops, p->loopNum, sizeof(Loop), compareLoopSize);
+    for (int i = 0; i < p->loopNum; i++) {
+        pLoop l = &p->loops[i];
+        l->parent = p->blocks[l->header].loop;
+        l->depth = l->parent < 0 ? 1 : p->loops[l->parent].depth + 1;
+        for (int j = 0; j < l->blockNum; j++) {
+            p->blocks[l->blocks[j]].loop = i;
+            p->blocks[l->blocks[j]].loopDepth = l->depth;
+        }
+    }
+    free(mark);
+    free(work);
+}
+
+// liveness func
+pLiveness newLiveness(pInterCodeList interCodeList) {
+    pLiveness l = (pLiveness)malloc(sizeof(Liveness));
+    assert(l != NULL);
+    l->list = interCodeList;
+    l->cfg = NULL;
+    l->keyNum = updateVarKeys(interCodeList);
+    l->globalOf = (int*)malloc(sizeof(int) * l->keyNum);
+    l->globals = (int*)malloc(sizeof(int) * l->keyNum);
+    l->defStamp = (int*)calloc(l->keyNum, sizeof(int));
+    assert(l->globalOf != NULL && l->globals != NULL && l->defStamp != NULL);
+    for (int i = 0; i < l->keyNum; i++)
+        l->globalOf[i] = -1;
+    l->globalNum = 0;
+    l->stamp = 0;
+    l->words = 0;
+    l->in = l->out = NULL;
+    l->uses = NULL;
+    l->useSize = 0;
+    return l;
+}
+
+void deleteLiveness(pLiveness l) {
+    if (l == NULL) return;
+    free(l->globalOf);
+    free(l->globals);
+    free(l->defStamp);
+    free(l->in);
+    free(l->out);
+    free(l->uses);
+    free(l);
+}
+
+static int addLiveUse(pLiveness l, int num, int index) {
+    int key = getVarKey(l->list, index);
+    if (key < 0) return num;
+    if (num == l->useSize) {
+        l->useSize = l->useSize == 0 ? 0x10 : l->useSize * 2;
+        l->uses = (int*)realloc(l->uses, sizeof(int) * l->useSize);
+        assert(l->uses != NULL);
+    }
+    l->uses[num] = key;
+    return num + 1;
+}
+
+int getLiveUses(pLiveness l, int i, int** uses) {
+    pInterCode codes = l->list->codes;
+    int num = 0;
+    if (codes[i].kind == IR_CALL) {
+        for (int j = i - 1; j >= 0 && codes[j].kind != IR_CALL && codes[j].kind != IR_LABEL &&
+                            codes[j].kind != IR_FUNCTION; j--)
+            if (codes[j].kind == IR_ARG) num = addLiveUse(l, num, codes[j].u.oneOp.op);
+    }
+    else if (codes[i].kind != IR_ARG) {
+        int* slots[3];
+        int slotNum = getCodeUses(&codes[i], slots);
+        for (int j = 0; j < slotNum; j++)
+            num = addLiveUse(l, num, *slots[j]);
+    }
+    *uses = l->uses;
+    return num;
+}
+
+void computeLiveness(pLiveness l, pCfg p) {
+    for (int k = 0; k < l->globalNum; k++)
+        l->globalOf[l->globals[k]] = -1;
+    l->globalNum = 0;
+    l->cfg = p;
+
+    // keys read before being written in some block
+    for (int b = 0; b < p->blockNum; b++) {
+        l->stamp++;
+        for (int i = p->blocks[b].first; i < p->blocks[b].last; i++) {
+            int* uses;
+            int useNum = getLiveUses(l, i, &uses);
+            for (int j = 0; j < useNum; j++)
+                if (l->globalOf[uses[j]] < 0 && l->defStamp[uses[j]] != l->stamp) {
+                    l->globalOf[uses[j]] = l->globalNum;
+                    l->globals[l->globalNum++] = uses[j];
+                }
+            int key = getVarKey(l->list, getCodeDef(&l->list->codes[i]));
+            if (key >= 0) l->defStamp[key] = l->stamp;
+        }
+    }
+
+    int words = l->words = (l->globalNum + LIVE_WORD_BITS - 1) / LIVE_WORD_BITS;
+    LiveWord* use = (LiveWord*)calloc(p->blockNum * words + 1, sizeof(LiveWord));
+    LiveWord* def = (LiveWord*)calloc(p->blockNum * words + 1, sizeof(LiveWord));
+    free(l->in);
+    free(l->out);
+    l->in = (LiveWord*)calloc(p->blockNum * words + 1, sizeof(LiveWord));
+    l->out = (LiveWord*)calloc(p->blockNum * words + 1, sizeof(LiveWord));
+    assert(use != NULL && def != NULL && l->in != NULL && l->out != NULL);
+    for (int b = 0; b < p->blockNum; b++) {
+        l->stamp++;
+        for (int i = p->blocks[b].first; i < p->blocks[b].last; i++) {
+            int* uses;
+            int useNum = getLiveUses(l, i, &uses);
+            for (int j = 0; j < useNum; j++) {
+                int g = l->globalOf[uses[j]];
+                if (g >= 0 && l->defStamp[uses[j]] != l->stamp)
+                    use[b * words + g / LIVE_WORD_BITS] |= (LiveWord)1 << (g % LIVE_WORD_BITS);
+            }
+            int key = getVarKey(l->list, getCodeDef(&l->list->codes[i]));
+            if (key < 0) continue;
+            l->defStamp[key] = l->stamp;
+            int g = l->globalOf[key];
+            if (g >= 0) def[b * words + g / LIVE_WORD_BITS] |= (LiveWord)1 << (g % LIVE_WORD_BITS);
+        }
+    }
+
+    boolean changed = TRUE;
+    while (changed) {
+        changed = FALSE;
+        for (int b = p->blockNum - 1; b >= 0; b--) {
+            pBasicBlock block = &p->blocks[b];
+            for (int w = 0; w < words; w++) {
+                LiveWord o = 0;
+                for (int s = 0; s < block->succNum; s++)
+                    o |= l->in[block->succ[s] * words + w];
+                LiveWord i = use[b * words + w] | (o & ~def[b * words + w]);
+                l->out[b * words + w] = o;
+                if (i != l->in[b * words + w]) {
+                    l->in[b * words + w] = i;
+                    changed = TRUE;
+                }
+            }
+        }
+    }
+    free(use);
+    free(def);
+}
+
+// dump func
+static void emitBlockDot(pOutBuffer out, pOutBuffer text, pCfg p, int prefix) {
+    for (int i = 0; i < p->blockNum; i++) {
+        pBasicBlock b = &p->blocks[i];
+        putString(out, "    f");
+        putInt(out, prefix);
+        putString(out, "_b");
+        putInt(out, i);
+        putString(out, " [label=\"B");
+        putInt(out, i);
+        if (b->idom >= 0) {
+            putString(out, "  idom B");
+            putInt(out, b->idom);
+        }
+        if (b->loopDepth > 0) {
+            putString(out, "  loop depth ");
+            putInt(out, b->loopDepth);
+        }
+        if (b->rpo < 0)
+            putString(out, "  unreachable");
+        putString(out, "\\l");
+        text->len = 0;
+        for (int j = b->first; j < b->last; j++)
+            emitCode(text, p->list, &p->list->codes[j]);
+        for (size_t j = 0; j < text->len; j++) {
+            if (text->buf[j] == '\n')
+                putString(out, "\\l");
+            else {
+                if (text->buf[j] == '"' || text->buf[j] == '\\') putChar(out, '\\');
+                putChar(out, text->buf[j]);
+            }
+        }
+        putString(out, "\"];\n");
+    }
+    for (int i = 0; i < p->blockNum; i++)
+        for (int j = 0; j < p->blocks[i].succNum; j++) {
+            putString(out, "    f");
+            putInt(out, prefix);
+            putString(out, "_b");
+            putInt(out, i);
+            putString(out, " -> f");
+            putInt(out, prefix);
+            putString(out, "_b");
+            putInt(out, p->blocks[i].succ[j]);
+            // a jump to the next block is still drawn as a fall through
+            putString(out, j == 0 && p->blocks[i].succ[0] == i + 1 ? ";\n" : " [style=bold];\n");
+        }
+}
+
+void printCfgDot(FILE* fp, pCfg p) {
+    pOutBuffer out = newOutBuffer(fp);
+    pOutBuffer text = newOutBuffer(NULL);
+    putString(out, "digraph cfg {\n    node [shape=box, fontname=monospace];\n");
+    emitBlockDot(out, text, p, 0);
+    putString(out, "}\n");
+    deleteOutBuffer(text);
+    deleteOutBuffer(out);
+}
+
+void printInterCodeDot(FILE* fp, pInterCodeList interCodeList) {
+    pOutBuffer out = newOutBuffer(fp);
+    pOutBuffer text = newOutBuffer(NULL);
+    putString(out, "digraph cfg {\n    node [shape=box, fontname=monospace];\n");
+    int funcNum = 0;
+    for (int i = 0; i < interCodeList->count; ) {
+        int last = getFunctionEnd(interCodeList, i);
+        if (interCodeList->codes[i].kind != IR_FUNCTION) {
+            i = last;
+            continue;
+        }
+        pCfg p = newCfg(interCodeList, i, last);
+        computeDominators(p);
+        computeLoops(p);
+        putString(out, "    subgraph cluster_");
+        putInt(out, funcNum);
+        putString(out, " {\n    label=\"");
+        putString(out, getOperand(interCodeList, interCodeList->codes[i].u.oneOp.op)->u.name);
+        putString(out, "\";\n");
+        emitBlockDot(out, text, p, funcNum);
+        putString(out, "    }\n");
+        deleteCfg(p);
+        funcNum++;
+        i = last;
+    }
+    putString(out, "}\n");
+    deleteOutBuffer(text);
+    deleteOutBuffer(out);
+}
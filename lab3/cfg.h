@@ -0,0 +1,94 @@
+#ifndef CFG_H
+#define CFG_H
+#include "inter.h"
+
+typedef struct basicBlock* pBasicBlock;
+typedef struct loop* pLoop;
+typedef struct cfg* pCfg;
+typedef struct liveness* pLiveness;
+
+typedef struct basicBlock {
+    int first, last;    // codes [first, last) of the interCodeList
+    int succ[2];        // fall through first, then the jump target
+    int succNum;
+    int* preds;         // points into cfg->predPool
+    int predNum;
+    int rpo;            // position in reverse postorder, -1 if unreachable
+    int idom;           // immediate dominator, -1 for the entry and unreachable blocks
+    int domPre, domPost;    // dominator tree interval, a dominates b iff a's contains b's
+    int loop;           // innermost loop containing the block, -1 if none
+    int loopDepth;
+} BasicBlock;
+
+typedef struct loop {
+    int header;
+    int* blocks;        // every block of the loop, nested loops included
+    int blockNum;
+    int parent;         // enclosing loop, -1 if outermost
+    int depth;          // 1 for outermost loops
+} Loop;
+
+// one function of the interCodeList, blocks[0] is the entry holding FUNCTION and the PARAMs
+typedef struct cfg {
+    pInterCodeList list;
+    int first, last;    // codes of the function
+    pBasicBlock blocks;
+    int blockNum;
+    int* blockOf;       // blockOf[i - first] is the block of code i
+    int* predPool;
+    int* order;         // reachable blocks in reverse postorder
+    int orderNum;
+    pLoop loops;        // outermost loops first
+    int loopNum;
+} Cfg;
+
+typedef unsigned long long LiveWord;
+#define LIVE_WORD_BITS 64
+
+// Liveness of the variables of one function for the backends, which pass the ARGs at their CALL,
+// so the ARG operands are read by the CALL instead. Only keys read before being written in some
+// block get a bit in the block sets, any other key is dead at every block boundary.
+typedef struct liveness {
+    pInterCodeList list;
+    pCfg cfg;
+    int keyNum;
+    int* globalOf;      // bit of a key in the block sets, -1 if none
+    int* globals;
+    int globalNum;
+    int* defStamp;
+    int stamp;
+    int words;          // per block in the sets
+    LiveWord* in;
+    LiveWord* out;
+    int* uses;          // buffer of getLiveUses
+    int useSize;
+} Liveness;
+
+// Cfg func
+int getFunctionEnd(pInterCodeList interCodeList, int first);
+pCfg newCfg(pInterCodeList interCodeList, int first, int last);
+void deleteCfg(pCfg p);
+
+// analysis func
+void computeDominators(pCfg p);
+void computeLoops(pCfg p);
+static inline boolean dominates(pCfg p, int a, int b) {
+    pBasicBlock x = &p->blocks[a], y = &p->blocks[b];
+    return x->rpo >= 0 && y->rpo >= 0 && x->domPre <= y->domPre && y->domPost <= x->domPost;
+}
+
+// liveness func
+pLiveness newLiveness(pInterCodeList interCodeList);
+void deleteLiveness(pLiveness l);
+void computeLiveness(pLiveness l, pCfg p);
+int getLiveUses(pLiveness l, int i, int** uses);
+static inline boolean isLiveOut(pLiveness l, int block, int key) {
+    int g = l->globalOf[key];
+    return g >= 0 && (l->out[block * l->words + g / LIVE_WORD_BITS] >> (g % LIVE_WORD_BITS)) & 1;
+}
+
+// dump func
+void printCfgDot(FILE* fp, pCfg p);
+void printInterCodeDot(FILE* fp, pInterCodeList interCodeList);
+
+#endif
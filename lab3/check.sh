@@ -0,0 +1,69 @@
+#!/bin/sh
+# regression checks for lab3, run after building the parser: ./check.sh [parser]
+#   testN.cmm translates to testN.ir
+#   testN.ir survives a round trip through the binary format, -b then -r
+#   testN.cmm compiles to the MIPS assembly testN.s with -s and the x86-64 assembly testN.x86.s
+#   with -x; testN.out is what it prints for the input testN.in under -i and, where cc is found,
+#   as a linked x86-64 program
+#   tests/X.cmm optimizes to tests/X.ir with -O, and runs with -i, with and without -O, printing
+#   tests/X.out for the input tests/X.in
+parser=$(realpath "${1:-./parser}")
+cd "$(dirname "$0")" || exit 1
+tmp=$(mktemp -d)
+trap 'rm -rf "$tmp"' EXIT
+fail=0
+
+# fails the check named $1 unless files $2 and $3 are equal
+expect() {
+    if ! cmp -s "$2" "$3"; then
+        echo "FAIL $1"
+        diff "$2" "$3" | head -10
+        fail=1
+    fi
+}
+
+for src in test*.cmm; do
+    name=${src%.cmm}
+    [ -f "$name.ir" ] || continue
+    "$parser" "$src" "$tmp/$name.ir" > /dev/null
+    expect "$name: IR" "$name.ir" "$tmp/$name.ir"
+    "$parser" -b "$src" "$tmp/$name.bin" > /dev/null && "$parser" -r "$tmp/$name.bin" "$tmp/$name.rt.ir"
+    expect "$name: binary round trip" "$name.ir" "$tmp/$name.rt.ir"
+    if [ -f "$name.s" ]; then
+        "$parser" -s "$src" "$tmp/$name.s" > /dev/null
+        expect "$name: MIPS" "$name.s" "$tmp/$name.s"
+    fi
+    if [ -f "$name.x86.s" ]; then
+        "$parser" -x "$src" "$tmp/$name.x86.s" > /dev/null
+        expect "$name: x86-64" "$name.x86.s" "$tmp/$name.x86.s"
+    fi
+    if [ -f "$name.out" ]; then
+        input=/dev/null
+        [ -f "$name.in" ] && input=$name.in
+        "$parser" -i "$src" "$tmp/run.out" < "$input" > /dev/null
+        expect "$name: -i output" "$name.out" "$tmp/run.out"
+        if command -v cc > /dev/null && cc -o "$tmp/$name" "$tmp/$name.x86.s" 2> /dev/null; then
+            "$tmp/$name" < "$input" > "$tmp/run.out"
+            expect "$name: x86-64 output" "$name.out" "$tmp/run.out"
+        fi
+    fi
+done
+
+for src in tests/*.cmm; do
+    name=${src%.cmm}
+    input=/dev/null
+    [ -f "$name.in" ] && input=$name.in
+    if [ -f "$name.ir" ]; then
+        "$parser" -O "$src" "$tmp/opt.ir" > /dev/null
+        expect "$name: -O IR" "$name.ir" "$tmp/opt.ir"
+    fi
+    if [ -f "$name.out" ]; then
+        "$parser" -i "$src" "$tmp/run.out" < "$input" > /dev/null
+        expect "$name: -i output" "$name.out" "$tmp/run.out"
+        "$parser" -i -O "$src" "$tmp/run.out" < "$input" > /dev/null
+        expect "$name: -i -O output" "$name.out" "$tmp/run.out"
+    fi
+done
+
+[ $fail -eq 0 ] && echo "all checks passed"
+exit $fail
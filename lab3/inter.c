@@ -3,14 +3,134 @@
 boolean interError = FALSE;
 pInterCodeList interCodeList;
 
+// NameTable func
+pNameTable newNameTable(unsigned size) {
+    assert((size & (size - 1)) == 0);
+    pNameTable p = (pNameTable)malloc(sizeof(NameTable));
+    assert(p != NULL);
+    p->names = (char**)calloc(size, sizeof(char*));
+    assert(p->names != NULL);
+    p->size = size;
+    p->count = 0;
+    p->arena = newArena(ARENA_BLOCK_SIZE);
+    return p;
+}
+
+void deleteNameTable(pNameTable p) {
+    assert(p != NULL);
+    deleteArena(p->arena);
+    free(p->names);
+    free(p);
+}
+
+char* internName(pNameTable p, char* name) {
+    assert(p != NULL && name != NULL);
+    unsigned mask = p->size - 1;
+    unsigned i = getHashCode(name) & mask;
+    while (p->names[i]) {
+        if (!strcmp(p->names[i], name))
+            return p->names[i];
+        i = (i + 1) & mask;
+    }
+    char* interned = arenaString(p->arena, name);
+    p->names[i] = interned;
+    p->count++;
+
+    // open addressing, keep at most half of the slots in use
+    if (p->count * 2 > p->size) {
+        char** oldNames = p->names;
+        unsigned oldSize = p->size;
+        p->size *= 2;
+        p->names = (char**)calloc(p->size, sizeof(char*));
+        assert(p->names != NULL);
+        mask = p->size - 1;
+        for (unsigned j = 0; j < oldSize; j++) {
+            if (oldNames[j] == NULL) continue;
+            unsigned k = getHashCode(oldNames[j]) & mask;
+            while (p->names[k])
+                k = (k + 1) & mask;
+            p->names[k] = oldNames[j];
+        }
+        free(oldNames);
+    }
+    return interned;
+}
+
+int getNameIndex(pNameTable p, char* name) {
+    assert(p != NULL && name != NULL);
+    unsigned mask = p->size - 1;
+    unsigned i = getHashCode(name) & mask;
+    while (p->names[i]) {
+        if (p->names[i] == name || !strcmp(p->names[i], name))
+            return i;
+        i = (i + 1) & mask;
+    }
+    return -1;
+}
+
+// OutBuffer func
+pOutBuffer newOutBuffer(FILE* fp) {
+    pOutBuffer p = (pOutBuffer)malloc(sizeof(OutBuffer));
+    assert(p != NULL);
+    p->fp = fp;
+    p->size = OUT_BUFFER_SIZE;
+    p->len = 0;
+    p->buf = (char*)malloc(p->size);
+    assert(p->buf != NULL);
+    return p;
+}
+
+void deleteOutBuffer(pOutBuffer p) {
+    assert(p != NULL);
+    flushOutBuffer(p);
+    free(p->buf);
+    free(p);
+}
+
+void flushOutBuffer(pOutBuffer p) {
+    assert(p != NULL);
+    if (p->fp == NULL || p->len == 0)
+        return;
+    size_t n = fwrite(p->buf, 1, p->len, p->fp);
+    assert(n == p->len);
+    fflush(p->fp);
+    p->len = 0;
+}
+
+void reserveOutBuffer(pOutBuffer p, size_t n) {
+    if (p->fp != NULL) {
+        flushOutBuffer(p);
+        if (n <= p->size)
+            return;
+    }
+    while (p->size - p->len < n)
+        p->size *= 2;
+    p->buf = (char*)realloc(p->buf, p->size);
+    assert(p->buf != NULL);
+}
+
 // Operand func
+pOperand allocOperand(pInterCodeList interCodeList) {
+    if (interCodeList->opCount >> OPERAND_BLOCK_SHIFT == interCodeList->opBlockNum) {
+        interCodeList->opBlockNum++;
+        interCodeList->opBlocks = (pOperand*)realloc(interCodeList->opBlocks, sizeof(pOperand) * interCodeList->opBlockNum);
+        assert(interCodeList->opBlocks != NULL);
+        interCodeList->opBlocks[interCodeList->opBlockNum - 1] = (pOperand)malloc(sizeof(Operand) * OPERAND_BLOCK_SIZE);
+        assert(interCodeList->opBlocks[interCodeList->opBlockNum - 1] != NULL);
+    }
+    int index = interCodeList->opCount++;
+    pOperand p = getOperand(interCodeList, index);
+    p->index = index;
+    p->no = 0;
+    return p;
+}
+
 pOperand newOperand(int kind, ...) {
-    pOperand p = (pOperand)malloc(sizeof(Operand));
-    assert(p != NULL);
+    pOperand p = allocOperand(interCodeList);
     p->kind = kind;
     va_list arg_ptr;
     assert(kind >= 0 && kind < 6);
-    va_start(arg_ptr, 1);
+    va_start(arg_ptr, kind);
     switch (kind) {
         case OP_CONSTANT:
             p->u.value = va_arg(arg_ptr, int);
@@ -23,6 +143,7 @@ pOperand newOperand(int kind, ...) {
             p->u.name = va_arg(arg_ptr, char*);
             break;
     }
+    va_end(arg_ptr);
     return p;
 }
 
@@ -30,80 +151,98 @@ void setOperand(pOperand p, int kind, void* val) {
     assert(p != NULL);
     assert(kind >= 0 && kind < 6);
     p->kind = kind;
+    p->no = 0;
     switch (kind) {
         case OP_CONSTANT:
-            p->u.value = (int)val;
+            p->u.value = (int)(long)val;
             break;
         case OP_VARIABLE:
         case OP_ADDRESS:
         case OP_LABEL:
         case OP_FUNCTION:
         case OP_RELOP:
-            if (p->u.name) free(p->u.name);
             p->u.name = (char*)val;
             break;
     }
 }
 
-void deleteOperand(pOperand p) {
-    if (p == NULL) return;
-    assert(p->kind >= 0 && p->kind < 6);
-    switch (p->kind) {
+int newConstant(pInterCodeList interCodeList, int value) {
+    pOperand p = allocOperand(interCodeList);
+    p->kind = OP_CONSTANT;
+    p->u.value = value;
+    return p->index;
+}
+
+// passes number variables densely, temps by their number and named variables from varBase on by
+// name slot. tempVarNum is no bound since the tempVarNum-- in translation can hand a number out again
+int updateVarKeys(pInterCodeList interCodeList) {
+    int maxNo = 0;
+    for (int i = 1; i < interCodeList->opCount; i++) {
+        pOperand op = getOperand(interCodeList, i);
+        if (op->kind != OP_LABEL && op->no > maxNo)
+            maxNo = op->no;
+    }
+    interCodeList->varBase = maxNo + 1;
+    return interCodeList->varBase + interCodeList->names->size;
+}
+
+int getVarKey(pInterCodeList interCodeList, int index) {
+    if (index == 0) return -1;
+    pOperand op = getOperand(interCodeList, index);
+    switch (op->kind) {
+        case OP_VARIABLE:
+        case OP_ADDRESS:
+            if (op->no != 0) {
+                assert(op->no < interCodeList->varBase);
+                return op->no;
+            }
+            return interCodeList->varBase + getNameIndex(interCodeList->names, op->u.name);
+        default:
+            return -1;
+    }
+}
+
+pItem getExpItem(pNode node) {
+    assert(node != NULL);
+    while (node->prod == P_EXP_PAREN)
+        node = node->child->sibling;
+    // Exp -> ID, any other expression has no symbol
+    return node->prod == P_EXP_ID ? node->child->item : NULL;
+}
+
+void printOp(pOutBuffer out, pOperand op) {
+    assert(op != NULL);
+    if (op->no != 0) {
+        putString(out, op->kind == OP_LABEL ? "label" : "t");
+        putInt(out, op->no);
+        return;
+    }
+    switch (op->kind) {
         case OP_CONSTANT:
+            putChar(out, '#');
+            putInt(out, op->u.value);
             break;
         case OP_VARIABLE:
         case OP_ADDRESS:
         case OP_LABEL:
         case OP_FUNCTION:
         case OP_RELOP:
-            if (p->u.name) {
-                free(p->u.name);
-                p->u.name = NULL;
-            }
+            putString(out, op->u.name);
             break;
     }
-    free(p);
 }
 
-void printOp(FILE* fp, pOperand op) {
+// InterCode func
+static int getOperandIndex(pOperand op) {
     assert(op != NULL);
-    if (fp == NULL) {
-        switch (op->kind) {
-            case OP_CONSTANT:
-                printf("#%d", op->u.value);
-                break;
-            case OP_VARIABLE:
-            case OP_ADDRESS:
-            case OP_LABEL:
-            case OP_FUNCTION:
-            case OP_RELOP:
-                printf("%s", op->u.name);
-                break;
-        }
-    } 
-    else {
-        switch (op->kind) {
-            case OP_CONSTANT:
-                fprintf(fp, "#%d", op->u.value);
-                break;
-            case OP_VARIABLE:
-            case OP_ADDRESS:
-            case OP_LABEL:
-            case OP_FUNCTION:
-            case OP_RELOP:
-                fprintf(fp, "%s", op->u.name);
-                break;
-        }
-    }
+    return op->index;
 }
 
-// InterCode func
-pInterCode newInterCode(int kind, ...) {
-    pInterCode p = (pInterCode)malloc(sizeof(InterCode));
-    assert(p != NULL);
-    p->kind = kind;
+InterCode newInterCode(int kind, ...) {
+    InterCode p = {.kind = kind};
     va_list arg_ptr;
-    assert(kind >= 0 && kind < 19);
+    assert(kind >= 0 && kind <= IR_NOP);
+    va_start(arg_ptr, kind);
     switch (kind) {
         case IR_LABEL:
         case IR_FUNCTION:
@@ -113,321 +252,161 @@ pInterCode newInterCode(int kind, ...) {
         case IR_PARAM:
         case IR_READ:
         case IR_WRITE:
-            va_start(arg_ptr, 1);
-            p->u.oneOp.op = va_arg(arg_ptr, pOperand);
+            p.u.oneOp.op = getOperandIndex(va_arg(arg_ptr, pOperand));
             break;
         case IR_ASSIGN:
         case IR_GET_ADDR:
         case IR_READ_ADDR:
         case IR_WRITE_ADDR:
         case IR_CALL:
-            va_start(arg_ptr, 2);
-            p->u.assign.left = va_arg(arg_ptr, pOperand);
-            p->u.assign.right = va_arg(arg_ptr, pOperand);
+            p.u.assign.left = getOperandIndex(va_arg(arg_ptr, pOperand));
+            p.u.assign.right = getOperandIndex(va_arg(arg_ptr, pOperand));
             break;
         case IR_ADD:
         case IR_SUB:
         case IR_MUL:
         case IR_DIV:
-            va_start(arg_ptr, 3);
-            p->u.binOp.result = va_arg(arg_ptr, pOperand);
-            p->u.binOp.op1 = va_arg(arg_ptr, pOperand);
-            p->u.binOp.op2 = va_arg(arg_ptr, pOperand);
+            p.u.binOp.result = getOperandIndex(va_arg(arg_ptr, pOperand));
+            p.u.binOp.op1 = getOperandIndex(va_arg(arg_ptr, pOperand));
+            p.u.binOp.op2 = getOperandIndex(va_arg(arg_ptr, pOperand));
             break;
         case IR_DEC:
-            va_start(arg_ptr, 2);
-            p->u.dec.op = va_arg(arg_ptr, pOperand);
-            p->u.dec.size = va_arg(arg_ptr, int);
+            p.u.dec.op = getOperandIndex(va_arg(arg_ptr, pOperand));
+            p.u.dec.size = va_arg(arg_ptr, int);
             break;
         case IR_IF_GOTO:
-            va_start(arg_ptr, 4);
-            p->u.ifGoto.x = va_arg(arg_ptr, pOperand);
-            p->u.ifGoto.relop = va_arg(arg_ptr, pOperand);
-            p->u.ifGoto.y = va_arg(arg_ptr, pOperand);
-            p->u.ifGoto.z = va_arg(arg_ptr, pOperand);
+            p.u.ifGoto.x = getOperandIndex(va_arg(arg_ptr, pOperand));
+            p.u.ifGoto.relop = getOperandIndex(va_arg(arg_ptr, pOperand));
+            p.u.ifGoto.y = getOperandIndex(va_arg(arg_ptr, pOperand));
+            p.u.ifGoto.z = getOperandIndex(va_arg(arg_ptr, pOperand));
+            break;
     }
+    va_end(arg_ptr);
     return p;
 }
 
-void deleteInterCode(pInterCode p) {
-    assert(p != NULL);
-    assert(p->kind >= 0 && p->kind < 19);
-    switch (p->kind) {
-        case IR_LABEL:
-        case IR_FUNCTION:
-        case IR_GOTO:
-        case IR_RETURN:
-        case IR_ARG:
-        case IR_PARAM:
-        case IR_READ:
-        case IR_WRITE:
-            deleteOperand(p->u.oneOp.op);
-            break;
+// per kind: text before op 0, op 0, text between, op 1, ... operands are taken from u.ops in the order below
+static const struct {
+    const char* text[6];
+    int ops[4];
+} codeFormat[] = {
+    [IR_LABEL]      = {{"LABEL ", " :\n"},                     {0}},
+    [IR_FUNCTION]   = {{"FUNCTION ", " :\n"},                  {0}},
+    [IR_ASSIGN]     = {{"", " := ", "\n"},                     {1, 0}},
+    [IR_ADD]        = {{"", " := ", " + ", "\n"},              {0, 1, 2}},
+    [IR_SUB]        = {{"", " := ", " - ", "\n"},              {0, 1, 2}},
+    [IR_MUL]        = {{"", " := ", " * ", "\n"},              {0, 1, 2}},
+    [IR_DIV]        = {{"", " := ", " / ", "\n"},              {0, 1, 2}},
+    [IR_GET_ADDR]   = {{"", " := &", "\n"},                    {1, 0}},
+    [IR_READ_ADDR]  = {{"", " := *", "\n"},                    {1, 0}},
+    [IR_WRITE_ADDR] = {{"*", " := ", "\n"},                    {1, 0}},
+    [IR_GOTO]       = {{"GOTO ", "\n"},                        {0}},
+    [IR_IF_GOTO]    = {{"IF ", " ", " ", " GOTO ", "\n"},      {0, 1, 2, 3}},
+    [IR_RETURN]     = {{"RETURN ", "\n"},                      {0}},
+    [IR_DEC]        = {{"DEC ", " "},                          {0}},
+    [IR_ARG]        = {{"ARG ", "\n"},                         {0}},
+    [IR_CALL]       = {{"", " := CALL ", "\n"},                {1, 0}},
+    [IR_PARAM]      = {{"PARAM ", "\n"},                       {0}},
+    [IR_READ]       = {{"READ ", "\n"},                        {0}},
+    [IR_WRITE]      = {{"WRITE ", "\n"},                       {0}},
+};
+
+void emitCode(pOutBuffer out, pInterCodeList interCodeList, pInterCode code) {
+    assert(code->kind >= 0 && code->kind <= IR_NOP);
+    if (code->kind == IR_NOP)
+        return;
+    const char* const* text = codeFormat[code->kind].text;
+    putString(out, text[0]);
+    for (int j = 1; text[j] != NULL; j++) {
+        printOp(out, getOperand(interCodeList, code->u.ops[codeFormat[code->kind].ops[j - 1]]));
+        putString(out, text[j]);
+    }
+    // the size of DEC is a number, not an operand
+    if (code->kind == IR_DEC) {
+        putInt(out, code->u.dec.size);
+        putChar(out, '\n');
+    }
+}
+
+void emitInterCode(pOutBuffer out, pInterCodeList interCodeList) {
+    for (int i = 0; i < interCodeList->count; i++)
+        emitCode(out, interCodeList, &interCodeList->codes[i]);
+}
+
+// the operand a code writes and the operand slots it reads as values, &x does not read x
+int* getCodeDefSlot(pInterCode code) {
+    switch (code->kind) {
         case IR_ASSIGN:
         case IR_GET_ADDR:
         case IR_READ_ADDR:
-        case IR_WRITE_ADDR:
         case IR_CALL:
-            deleteOperand(p->u.assign.left);
-            deleteOperand(p->u.assign.right);
-            break;
+            return &code->u.assign.left;
         case IR_ADD:
         case IR_SUB:
         case IR_MUL:
         case IR_DIV:
-            deleteOperand(p->u.binOp.result);
-            deleteOperand(p->u.binOp.op1);
-            deleteOperand(p->u.binOp.op2);
-            break;
-        case IR_DEC:
-            deleteOperand(p->u.dec.op);
-            break;
-        case IR_IF_GOTO:
-            deleteOperand(p->u.ifGoto.x);
-            deleteOperand(p->u.ifGoto.relop);
-            deleteOperand(p->u.ifGoto.y);
-            deleteOperand(p->u.ifGoto.z);
+            return &code->u.binOp.result;
+        case IR_PARAM:
+        case IR_READ:
+            return &code->u.oneOp.op;
+        default:
+            return NULL;
     }
-    free(p);
 }
 
-void printInterCode(FILE* fp, pInterCodeList interCodeList) {
-    for (pInterCodes cur = interCodeList->head; cur != NULL; cur = cur->next) {
-        assert(cur->code->kind >= 0 && cur->code->kind < 19);
-        if (fp == NULL) {
-            switch (cur->code->kind) {
-                case IR_LABEL:
-                    printf("LABEL ");
-                    printOp(fp, cur->code->u.oneOp.op);
-                    printf(" :");
-                    break;
-                case IR_FUNCTION:
-                    printf("FUNCTION ");
-                    printOp(fp, cur->code->u.oneOp.op);
-                    printf(" :");
-                    break;
-                case IR_ASSIGN:
-                    printOp(fp, cur->code->u.assign.left);
-                    printf(" := ");
-                    printOp(fp, cur->code->u.assign.right);
-                    break;
-                case IR_ADD:
-                    printOp(fp, cur->code->u.binOp.result);
-                    printf(" := ");
-                    printOp(fp, cur->code->u.binOp.op1);
-                    printf(" + ");
-                    printOp(fp, cur->code->u.binOp.op2);
-                    break;
-                case IR_SUB:
-                    printOp(fp, cur->code->u.binOp.result);
-                    printf(" := ");
-                    printOp(fp, cur->code->u.binOp.op1);
-                    printf(" - ");
-                    printOp(fp, cur->code->u.binOp.op2);
-                    break;
-                case IR_MUL:
-                    printOp(fp, cur->code->u.binOp.result);
-                    printf(" := ");
-                    printOp(fp, cur->code->u.binOp.op1);
-                    printf(" * ");
-                    printOp(fp, cur->code->u.binOp.op2);
-                    break;
-                case IR_DIV:
-                    printOp(fp, cur->code->u.binOp.result);
-                    printf(" := ");
-                    printOp(fp, cur->code->u.binOp.op1);
-                    printf(" / ");
-                    printOp(fp, cur->code->u.binOp.op2);
-                    break;
-                case IR_GET_ADDR:
-                    printOp(fp, cur->code->u.assign.left);
-                    printf(" := &");
-                    printOp(fp, cur->code->u.assign.right);
-                    break;
-                case IR_READ_ADDR:
-                    printOp(fp, cur->code->u.assign.left);
-                    printf(" := *");
-                    printOp(fp, cur->code->u.assign.right);
-                    break;
-                case IR_WRITE_ADDR:
-                    printf("*");
-                    printOp(fp, cur->code->u.assign.left);
-                    printf(" := ");
-                    printOp(fp, cur->code->u.assign.right);
-                    break;
-                case IR_GOTO:
-                    printf("GOTO ");
-                    printOp(fp, cur->code->u.oneOp.op);
-                    break;
-                case IR_IF_GOTO:
-                    printf("IF ");
-                    printOp(fp, cur->code->u.ifGoto.x);
-                    printf(" ");
-                    printOp(fp, cur->code->u.ifGoto.relop);
-                    printf(" ");
-                    printOp(fp, cur->code->u.ifGoto.y);
-                    printf(" GOTO ");
-                    printOp(fp, cur->code->u.ifGoto.z);
-                    break;
-                case IR_RETURN:
-                    printf("RETURN ");
-                    printOp(fp, cur->code->u.oneOp.op);
-                    break;
-                case IR_DEC:
-                    printf("DEC ");
-                    printOp(fp, cur->code->u.dec.op);
-                    printf(" ");
-                    printf("%d", cur->code->u.dec.size);
-                    break;
-                case IR_ARG:
-                    printf("ARG ");
-                    printOp(fp, cur->code->u.oneOp.op);
-                    break;
-                case IR_CALL:
-                    printOp(fp, cur->code->u.assign.left);
-                    printf(" := CALL ");
-                    printOp(fp, cur->code->u.assign.right);
-                    break;
-                case IR_PARAM:
-                    printf("PARAM ");
-                    printOp(fp, cur->code->u.oneOp.op);
-                    break;
-                case IR_READ:
-                    printf("READ ");
-                    printOp(fp, cur->code->u.oneOp.op);
-                    break;
-                case IR_WRITE:
-                    printf("WRITE ");
-                    printOp(fp, cur->code->u.oneOp.op);
-                    break;
-            }
-            printf("\n");
-        } 
-        else {
-            switch (cur->code->kind) {
-                case IR_LABEL:
-                    fprintf(fp, "LABEL ");
-                    printOp(fp, cur->code->u.oneOp.op);
-                    fprintf(fp, " :");
-                    break;
-                case IR_FUNCTION:
-                    fprintf(fp, "FUNCTION ");
-                    printOp(fp, cur->code->u.oneOp.op);
-                    fprintf(fp, " :");
-                    break;
-                case IR_ASSIGN:
-                    printOp(fp, cur->code->u.assign.left);
-                    fprintf(fp, " := ");
-                    printOp(fp, cur->code->u.assign.right);
-                    break;
-                case IR_ADD:
-                    printOp(fp, cur->code->u.binOp.result);
-                    fprintf(fp, " := ");
-                    printOp(fp, cur->code->u.binOp.op1);
-                    fprintf(fp, " + ");
-                    printOp(fp, cur->code->u.binOp.op2);
-                    break;
-                case IR_SUB:
-                    printOp(fp, cur->code->u.binOp.result);
-                    fprintf(fp, " := ");
-                    printOp(fp, cur->code->u.binOp.op1);
-                    fprintf(fp, " - ");
-                    printOp(fp, cur->code->u.binOp.op2);
-                    break;
-                case IR_MUL:
-                    printOp(fp, cur->code->u.binOp.result);
-                    fprintf(fp, " := ");
-                    printOp(fp, cur->code->u.binOp.op1);
-                    fprintf(fp, " * ");
-                    printOp(fp, cur->code->u.binOp.op2);
-                    break;
-                case IR_DIV:
-                    printOp(fp, cur->code->u.binOp.result);
-                    fprintf(fp, " := ");
-                    printOp(fp, cur->code->u.binOp.op1);
-                    fprintf(fp, " / ");
-                    printOp(fp, cur->code->u.binOp.op2);
-                    break;
-                case IR_GET_ADDR:
-                    printOp(fp, cur->code->u.assign.left);
-                    fprintf(fp, " := &");
-                    printOp(fp, cur->code->u.assign.right);
-                    break;
-                case IR_READ_ADDR:
-                    printOp(fp, cur->code->u.assign.left);
-                    fprintf(fp, " := *");
-                    printOp(fp, cur->code->u.assign.right);
-                    break;
-                case IR_WRITE_ADDR:
-                    fprintf(fp, "*");
-                    printOp(fp, cur->code->u.assign.left);
-                    fprintf(fp, " := ");
-                    printOp(fp, cur->code->u.assign.right);
-                    break;
-                case IR_GOTO:
-                    fprintf(fp, "GOTO ");
-                    printOp(fp, cur->code->u.oneOp.op);
-                    break;
-                case IR_IF_GOTO:
-                    fprintf(fp, "IF ");
-                    printOp(fp, cur->code->u.ifGoto.x);
-                    fprintf(fp, " ");
-                    printOp(fp, cur->code->u.ifGoto.relop);
-                    fprintf(fp, " ");
-                    printOp(fp, cur->code->u.ifGoto.y);
-                    fprintf(fp, " GOTO ");
-                    printOp(fp, cur->code->u.ifGoto.z);
-                    break;
-                case IR_RETURN:
-                    fprintf(fp, "RETURN ");
-                    printOp(fp, cur->code->u.oneOp.op);
-                    break;
-                case IR_DEC:
-                    fprintf(fp, "DEC ");
-                    printOp(fp, cur->code->u.dec.op);
-                    fprintf(fp, " ");
-                    fprintf(fp, "%d", cur->code->u.dec.size);
-                    break;
-                case IR_ARG:
-                    fprintf(fp, "ARG ");
-                    printOp(fp, cur->code->u.oneOp.op);
-                    break;
-                case IR_CALL:
-                    printOp(fp, cur->code->u.assign.left);
-                    fprintf(fp, " := CALL ");
-                    printOp(fp, cur->code->u.assign.right);
-                    break;
-                case IR_PARAM:
-                    fprintf(fp, "PARAM ");
-                    printOp(fp, cur->code->u.oneOp.op);
-                    break;
-                case IR_READ:
-                    fprintf(fp, "READ ");
-                    printOp(fp, cur->code->u.oneOp.op);
-                    break;
-                case IR_WRITE:
-                    fprintf(fp, "WRITE ");
-                    printOp(fp, cur->code->u.oneOp.op);
-                    break;
-            }
-            fprintf(fp, "\n");
-        }
+int getCodeDef(pInterCode code) {
+    int* def = getCodeDefSlot(code);
+    return def == NULL ? 0 : *def;
+}
+
+int getCodeUses(pInterCode code, int* uses[3]) {
+    switch (code->kind) {
+        case IR_ASSIGN:
+        case IR_READ_ADDR:
+            uses[0] = &code->u.assign.right;
+            return 1;
+        case IR_WRITE_ADDR:
+            uses[0] = &code->u.assign.left;
+            uses[1] = &code->u.assign.right;
+            return 2;
+        case IR_ADD:
+        case IR_SUB:
+        case IR_MUL:
+        case IR_DIV:
+            uses[0] = &code->u.binOp.op1;
+            uses[1] = &code->u.binOp.op2;
+            return 2;
+        case IR_IF_GOTO:
+            uses[0] = &code->u.ifGoto.x;
+            uses[1] = &code->u.ifGoto.y;
+            return 2;
+        case IR_RETURN:
+        case IR_ARG:
+        case IR_WRITE:
+            uses[0] = &code->u.oneOp.op;
+            return 1;
+        default:
+            return 0;
     }
 }
 
-// InterCodes func
-pInterCodes newInterCodes(pInterCode code) {
-    pInterCodes p = (pInterCodes)malloc(sizeof(InterCodes));
-    assert(p != NULL);
-    p->code = code;
-    p->prev = NULL;
-    p->next = NULL;
+void printInterCode(FILE* fp, pInterCodeList interCodeList) {
+    pOutBuffer out = newOutBuffer(fp == NULL ? stdout : fp);
+    emitInterCode(out, interCodeList);
+    deleteOutBuffer(out);
 }
 
-void deleteInterCodes(pInterCodes p) {
-    assert(p != NULL);
-    deleteInterCode(p->code);
-    free(p);
+// formats the IR in memory for callers that don't write a file; the text is 0 terminated, *len gets its
+// length without the 0 and the caller frees it
+char* printInterCodeToBuffer(pInterCodeList interCodeList, size_t* len) {
+    pOutBuffer out = newOutBuffer(NULL);
+    emitInterCode(out, interCodeList);
+    putChar(out, '\0');
+    char* text = out->buf;
+    if (len != NULL)
+        *len = out->len - 1;
+    free(out);
+    return text;
 }
 
 // Arg and ArgList func
@@ -435,7 +414,9 @@ pArg newArg(pOperand op) {
     pArg p = (pArg)malloc(sizeof(Arg));
     assert(p != NULL);
     p->op = op;
+    p->item = NULL;
     p->next = NULL;
+    return p;
 }
 
 pArgList newArgList() {
@@ -443,11 +424,11 @@ pArgList newArgList() {
     assert(p != NULL);
     p->head = NULL;
     p->cur = NULL;
+    return p;
 }
 
 void deleteArg(pArg p) {
     assert(p != NULL);
-    deleteOperand(p->op);
     free(p);
 }
 
@@ -475,74 +456,318 @@ void addArg(pArgList argList, pArg arg) {
 // InterCodeList func
 pInterCodeList newInterCodeList() {
     pInterCodeList p = (pInterCodeList)malloc(sizeof(InterCodeList));
-    p->head = NULL;
-    p->cur = NULL;
-    p->lastArrayName = NULL;
+    assert(p != NULL);
+    p->codes = (pInterCode)malloc(sizeof(InterCode) * INTER_CODE_INIT_SIZE);
+    assert(p->codes != NULL);
+    p->count = 0;
+    p->capacity = INTER_CODE_INIT_SIZE;
+    // slot 0 of the operand pool is reserved so that index 0 means no operand
+    p->opBlocks = (pOperand*)malloc(sizeof(pOperand));
+    assert(p->opBlocks != NULL);
+    p->opBlocks[0] = (pOperand)malloc(sizeof(Operand) * OPERAND_BLOCK_SIZE);
+    assert(p->opBlocks[0] != NULL);
+    p->opCount = 1;
+    p->opBlockNum = 1;
+    p->names = newNameTable(NAME_TABLE_INIT_SIZE);
     p->tempVarNum = 1;
     p->labelNum = 1;
+    p->varBase = 1;
+    return p;
 }
 
 void deleteInterCodeList(pInterCodeList p) {
     assert(p != NULL);
-    pInterCodes q = p->head;
-    while (q) {
-        pInterCodes temp = q;
-        q = q->next;
-        deleteInterCodes(temp);
-    }
+    for (int i = 0; i < p->opBlockNum; i++)
+        free(p->opBlocks[i]);
+    free(p->opBlocks);
+    free(p->codes);
+    deleteNameTable(p->names);
     free(p);
 }
 
-void addInterCode(pInterCodeList interCodeList, pInterCodes newCode) {
-    if (interCodeList->head == NULL) {
-        interCodeList->head = newCode;
-        interCodeList->cur = newCode;
-    } else {
-        interCodeList->cur->next = newCode;
-        newCode->prev = interCodeList->cur;
-        interCodeList->cur = newCode;
+// drops the codes, operands and names and numbers temps and labels from 1 again
+void clearInterCodeList(pInterCodeList p) {
+    assert(p != NULL);
+    for (int i = 1; i < p->opBlockNum; i++)
+        free(p->opBlocks[i]);
+    p->opBlockNum = 1;
+    p->opCount = 1;
+    p->count = 0;
+    deleteNameTable(p->names);
+    p->names = newNameTable(NAME_TABLE_INIT_SIZE);
+    p->tempVarNum = 1;
+    p->labelNum = 1;
+    p->varBase = 1;
+}
+
+// moves temps past tempBase and labels past labelBase, so lists numbered from 1 one after another
+// print as one program
+void shiftInterCodeNumbers(pInterCodeList p, int tempBase, int labelBase) {
+    assert(p != NULL);
+    for (int i = 1; i < p->opCount; i++) {
+        pOperand op = getOperand(p, i);
+        if (op->no != 0)
+            op->no += op->kind == OP_LABEL ? labelBase : tempBase;
+    }
+}
+
+static void reserveInterCodes(pInterCodeList interCodeList, int count) {
+    if (count <= interCodeList->capacity)
+        return;
+    while (interCodeList->capacity < count)
+        interCodeList->capacity *= 2;
+    interCodeList->codes = (pInterCode)realloc(interCodeList->codes, sizeof(InterCode) * interCodeList->capacity);
+    assert(interCodeList->codes != NULL);
+}
+
+void addInterCode(pInterCodeList interCodeList, InterCode newCode) {
+    reserveInterCodes(interCodeList, interCodeList->count + 1);
+    interCodeList->codes[interCodeList->count++] = newCode;
+}
+
+void insertInterCode(pInterCodeList interCodeList, int pos, InterCode newCode) {
+    assert(pos >= 0 && pos <= interCodeList->count);
+    reserveInterCodes(interCodeList, interCodeList->count + 1);
+    memmove(&interCodeList->codes[pos + 1], &interCodeList->codes[pos], sizeof(InterCode) * (interCodeList->count - pos));
+    interCodeList->codes[pos] = newCode;
+    interCodeList->count++;
+}
+
+void eraseInterCode(pInterCodeList interCodeList, int pos) {
+    assert(pos >= 0 && pos < interCodeList->count);
+    memmove(&interCodeList->codes[pos], &interCodeList->codes[pos + 1], sizeof(InterCode) * (interCodeList->count - pos - 1));
+    interCodeList->count--;
+}
+
+// passes that drop many codes mark them IR_NOP and compact once instead of erasing one by one
+void compactInterCodes(pInterCodeList interCodeList) {
+    int n = 0;
+    for (int i = 0; i < interCodeList->count; i++)
+        if (interCodeList->codes[i].kind != IR_NOP)
+            interCodeList->codes[n++] = interCodeList->codes[i];
+    interCodeList->count = n;
+}
+
+// binary IR func
+// layout: magic, names (count, then length + bytes each), operands (count, then kind, no and
+// value or name index each), codes (count, then kind and operand indices each, DEC adds its size),
+// every number is an unsigned LEB128 varint, constants are zigzag encoded first
+static const int codeOpNum[] = {
+    [IR_LABEL] = 1, [IR_FUNCTION] = 1, [IR_ASSIGN] = 2, [IR_ADD] = 3, [IR_SUB] = 3,
+    [IR_MUL] = 3, [IR_DIV] = 3, [IR_GET_ADDR] = 2, [IR_READ_ADDR] = 2, [IR_WRITE_ADDR] = 2,
+    [IR_GOTO] = 1, [IR_IF_GOTO] = 4, [IR_RETURN] = 1, [IR_DEC] = 1, [IR_ARG] = 1,
+    [IR_CALL] = 2, [IR_PARAM] = 1, [IR_READ] = 1, [IR_WRITE] = 1, [IR_NOP] = 0,
+};
+
+static void putVarint(pOutBuffer out, unsigned val) {
+    while (val >= 0x80) {
+        putChar(out, (char)(val | 0x80));
+        val >>= 7;
+    }
+    putChar(out, (char)val);
+}
+
+void writeInterCode(FILE* fp, pInterCodeList interCodeList) {
+    pNameTable names = interCodeList->names;
+    pOutBuffer out = newOutBuffer(fp);
+    putString(out, IR_BINARY_MAGIC);
+
+    // names are numbered in table order, slotIndex maps a table slot to that number
+    int* slotIndex = (int*)malloc(sizeof(int) * names->size);
+    assert(slotIndex != NULL);
+    putVarint(out, names->count);
+    for (unsigned i = 0, n = 0; i < names->size; i++) {
+        if (names->names[i] == NULL) continue;
+        slotIndex[i] = n++;
+        size_t len = strlen(names->names[i]);
+        putVarint(out, len);
+        putBytes(out, names->names[i], len);
+    }
+
+    putVarint(out, interCodeList->opCount - 1);
+    for (int i = 1; i < interCodeList->opCount; i++) {
+        pOperand op = getOperand(interCodeList, i);
+        putChar(out, (char)op->kind);
+        putVarint(out, op->no);
+        if (op->no != 0) continue;
+        if (op->kind == OP_CONSTANT)
+            putVarint(out, ((unsigned)op->u.value << 1) ^ (unsigned)(op->u.value >> 31));
+        else {
+            int slot = getNameIndex(names, op->u.name);
+            assert(slot >= 0);
+            putVarint(out, slotIndex[slot]);
+        }
+    }
+
+    int count = 0;
+    for (int i = 0; i < interCodeList->count; i++)
+        if (interCodeList->codes[i].kind != IR_NOP) count++;
+    putVarint(out, count);
+    for (int i = 0; i < interCodeList->count; i++) {
+        pInterCode cur = &interCodeList->codes[i];
+        if (cur->kind == IR_NOP) continue;
+        putChar(out, (char)cur->kind);
+        for (int j = 0; j < codeOpNum[cur->kind]; j++)
+            putVarint(out, cur->u.ops[j]);
+        if (cur->kind == IR_DEC)
+            putVarint(out, cur->u.dec.size);
+    }
+
+    free(slotIndex);
+    deleteOutBuffer(out);
+}
+
+typedef struct {
+    unsigned char* pos;
+    unsigned char* end;
+    boolean error;
+} BinaryReader;
+
+static unsigned getVarint(BinaryReader* r) {
+    unsigned val = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        if (r->pos == r->end) break;
+        unsigned char c = *r->pos++;
+        val |= (unsigned)(c & 0x7f) << shift;
+        if (!(c & 0x80)) return val;
+    }
+    r->error = TRUE;
+    return 0;
+}
+
+static unsigned getByte(BinaryReader* r) {
+    if (r->pos == r->end) {
+        r->error = TRUE;
+        return 0;
+    }
+    return *r->pos++;
+}
+
+pInterCodeList readInterCode(FILE* fp) {
+    // slurp the whole file, the reader is a cursor over it
+    size_t size = 0, cap = OUT_BUFFER_SIZE;
+    unsigned char* data = (unsigned char*)malloc(cap);
+    assert(data != NULL);
+    size_t n;
+    while ((n = fread(data + size, 1, cap - size, fp)) > 0) {
+        size += n;
+        if (size == cap) {
+            cap *= 2;
+            data = (unsigned char*)realloc(data, cap);
+            assert(data != NULL);
+        }
+    }
+    size_t magicLen = strlen(IR_BINARY_MAGIC);
+    if (size < magicLen || memcmp(data, IR_BINARY_MAGIC, magicLen)) {
+        free(data);
+        return NULL;
+    }
+    BinaryReader r = {data + magicLen, data + size, FALSE};
+
+    pInterCodeList p = newInterCodeList();
+    pInterCodeList saved = interCodeList;
+    interCodeList = p;
+
+    unsigned nameNum = getVarint(&r);
+    if (nameNum > size)
+        r.error = TRUE;
+    nameNum = r.error ? 0 : nameNum;
+    char** names = (char**)malloc(sizeof(char*) * (nameNum + 1));
+    assert(names != NULL);
+    char* tmp = (char*)malloc(1);
+    assert(tmp != NULL);
+    for (unsigned i = 0; i < nameNum && !r.error; i++) {
+        unsigned len = getVarint(&r);
+        if (len > (size_t)(r.end - r.pos)) {
+            r.error = TRUE;
+            break;
+        }
+        tmp = (char*)realloc(tmp, len + 1);
+        assert(tmp != NULL);
+        memcpy(tmp, r.pos, len);
+        tmp[len] = '\0';
+        r.pos += len;
+        names[i] = internName(p->names, tmp);
     }
+    free(tmp);
+
+    unsigned opNum = r.error ? 0 : getVarint(&r);
+    for (unsigned i = 0; i < opNum && !r.error; i++) {
+        unsigned kind = getByte(&r);
+        int no = getVarint(&r);
+        if (kind > OP_RELOP) {
+            r.error = TRUE;
+            break;
+        }
+        pOperand op = NULL;
+        if (no != 0) {
+            op = newOperand(kind, NULL);
+            op->no = no;
+            if (kind == OP_LABEL && no >= p->labelNum) p->labelNum = no + 1;
+            if (kind != OP_LABEL && no >= p->tempVarNum) p->tempVarNum = no + 1;
+        }
+        else if (kind == OP_CONSTANT) {
+            unsigned val = getVarint(&r);
+            op = newOperand(kind, (int)((val >> 1) ^ -(val & 1)));
+        }
+        else {
+            unsigned index = getVarint(&r);
+            if (index >= nameNum) {
+                r.error = TRUE;
+                break;
+            }
+            op = newOperand(kind, names[index]);
+        }
+    }
+    free(names);
+
+    unsigned codeNum = r.error ? 0 : getVarint(&r);
+    for (unsigned i = 0; i < codeNum && !r.error; i++) {
+        InterCode code = {.kind = getByte(&r)};
+        if (code.kind >= IR_NOP) {
+            r.error = TRUE;
+            break;
+        }
+        for (int j = 0; j < codeOpNum[code.kind]; j++) {
+            code.u.ops[j] = getVarint(&r);
+            if (code.u.ops[j] <= 0 || code.u.ops[j] >= p->opCount)
+                r.error = TRUE;
+        }
+        if (code.kind == IR_DEC)
+            code.u.dec.size = getVarint(&r);
+        addInterCode(p, code);
+    }
+
+    free(data);
+    interCodeList = saved;
+    if (r.error) {
+        deleteInterCodeList(p);
+        return NULL;
+    }
+    return p;
 }
 
 // traverse func
 pOperand newTemp() {
-    char tName[10] = {0};
-    sprintf(tName, "t%d", interCodeList->tempVarNum);
-    interCodeList->tempVarNum++;
-    pOperand temp = newOperand(OP_VARIABLE, newString(tName));
+    pOperand temp = newOperand(OP_VARIABLE, NULL);
+    temp->no = interCodeList->tempVarNum++;
     return temp;
 }
 
 pOperand newLabel() {
-    char lName[10] = {0};
-    sprintf(lName, "label%d", interCodeList->labelNum);
-    interCodeList->labelNum++;
-    pOperand temp = newOperand(OP_LABEL, newString(lName));
+    pOperand temp = newOperand(OP_LABEL, NULL);
+    temp->no = interCodeList->labelNum++;
     return temp;
 }
 
+// sizes are computed with the types, see layoutStruct
 int getSize(pType type) {
-    if (type == NULL)
-        return 0;
-    else if (type->kind == BASIC)
-        return 4;
-    else if (type->kind == ARRAY)
-        return type->u.array.size * getSize(type->u.array.elem);
-    else if (type->kind == STRUCTURE) {
-        int size = 0;
-        pFieldList temp = type->u.structure.field;
-        while (temp) {
-            size += getSize(temp->type);
-            temp = temp->tail;
-        }
-        return size;
-    }
-    return 0;
+    return type == NULL ? 0 : type->size;
 }
 
 void genInterCodes(pNode node) {
     if (node == NULL) return;
-    if (!strcmp(node->name, "ExtDefList"))
+    if (node->name == N_ExtDefList)
         translateExtDefList(node);
     else {
         genInterCodes(node->child);
@@ -550,13 +775,26 @@ void genInterCodes(pNode node) {
     }
 }
 
+// one walk for both passes, each ExtDef is translated right after it is checked while its subtree is
+// still in cache, C-- has no forward references so nothing checked later changes its translation
+void checkAndGenInterCodes(pNode node) {
+    if (node == NULL) return;
+    if (node->name != N_ExtDefList) {
+        checkAndGenInterCodes(node->child);
+        return;
+    }
+    for (pNode p = node; p != NULL; p = p->child->sibling) {
+        ExtDef(p->child);
+        translateExtDef(p->child);
+    }
+}
+
 void genInterCode(int kind, ...) {
     va_list arg_ptr;
     pOperand temp = NULL;
     pOperand result = NULL, op1 = NULL, op2 = NULL, relop = NULL;
     int size = 0;
-    pInterCodes newCode = NULL;
-    assert(kind >= 0 && kind < 19);
+    assert(kind >= 0 && kind < IR_NOP);
     switch (kind) {
         case IR_LABEL:
         case IR_FUNCTION:
@@ -566,22 +804,21 @@ void genInterCode(int kind, ...) {
         case IR_PARAM:
         case IR_READ:
         case IR_WRITE:
-            va_start(arg_ptr, 1);
+            va_start(arg_ptr, kind);
             op1 = va_arg(arg_ptr, pOperand);
             if (op1->kind == OP_ADDRESS) {
                 temp = newTemp();
                 genInterCode(IR_READ_ADDR, temp, op1);
                 op1 = temp;
             }
-            newCode = newInterCodes(newInterCode(kind, op1));
-            addInterCode(interCodeList, newCode);
+            addInterCode(interCodeList, newInterCode(kind, op1));
             break;
         case IR_ASSIGN:
         case IR_GET_ADDR:
         case IR_READ_ADDR:
         case IR_WRITE_ADDR:
         case IR_CALL:
-            va_start(arg_ptr, 2);
+            va_start(arg_ptr, kind);
             op1 = va_arg(arg_ptr, pOperand);
             op2 = va_arg(arg_ptr, pOperand);
             if (kind == IR_ASSIGN && (op1->kind == OP_ADDRESS || op2->kind == OP_ADDRESS)) {
@@ -596,15 +833,14 @@ void genInterCode(int kind, ...) {
                 }
             }
             else {
-                newCode = newInterCodes(newInterCode(kind, op1, op2));
-                addInterCode(interCodeList, newCode);
+                addInterCode(interCodeList, newInterCode(kind, op1, op2));
             }
             break;
         case IR_ADD:
         case IR_SUB:
         case IR_MUL:
         case IR_DIV:
-            va_start(arg_ptr, 3);
+            va_start(arg_ptr, kind);
             result = va_arg(arg_ptr, pOperand);
             op1 = va_arg(arg_ptr, pOperand);
             op2 = va_arg(arg_ptr, pOperand);
@@ -618,24 +854,21 @@ void genInterCode(int kind, ...) {
                 genInterCode(IR_READ_ADDR, temp, op2);
                 op2 = temp;
             }
-            newCode = newInterCodes(newInterCode(kind, result, op1, op2));
-            addInterCode(interCodeList, newCode);
+            addInterCode(interCodeList, newInterCode(kind, result, op1, op2));
             break;
         case IR_DEC:
-            va_start(arg_ptr, 2);
+            va_start(arg_ptr, kind);
             op1 = va_arg(arg_ptr, pOperand);
             size = va_arg(arg_ptr, int);
-            newCode = newInterCodes(newInterCode(kind, op1, size));
-            addInterCode(interCodeList, newCode);
+            addInterCode(interCodeList, newInterCode(kind, op1, size));
             break;
         case IR_IF_GOTO:
-            va_start(arg_ptr, 4);
+            va_start(arg_ptr, kind);
             result = va_arg(arg_ptr, pOperand);
             relop = va_arg(arg_ptr, pOperand);
             op1 = va_arg(arg_ptr, pOperand);
             op2 = va_arg(arg_ptr, pOperand);
-            newCode = newInterCodes(newInterCode(kind, result, relop, op1, op2));
-            addInterCode(interCodeList, newCode);
+            addInterCode(interCodeList, newInterCode(kind, result, relop, op1, op2));
             break;
     }
 }
@@ -655,7 +888,7 @@ void translateExtDef(pNode node) {
     // ExtDef -> Specifier ExtDecList SEMI
     //         | Specifier SEMI
     //         | Specifier FunDec CompSt
-    if (!strcmp(node->child->sibling->name, "FunDec")) {
+    if (node->child->sibling->name == N_FunDec) {
         translateFunDec(node->child->sibling);
         translateCompSt(node->child->sibling->sibling);
     }
@@ -666,12 +899,12 @@ void translateFunDec(pNode node) {
     if (interError) return;
     // FunDec -> ID LP VarList RP
     //         | ID LP RP
-    genInterCode(IR_FUNCTION, newOperand(OP_FUNCTION, newString(node->child->val)));
+    genInterCode(IR_FUNCTION, newOperand(OP_FUNCTION, internName(interCodeList->names, node->child->val)));
 
-    pItem funcItem = searchTableItem(table, node->child->val);
+    pItem funcItem = node->child->item;
     pFieldList temp = funcItem->field->type->u.function.argv;
     while (temp) {
-        genInterCode(IR_PARAM, newOperand(OP_VARIABLE, newString(temp->name)));
+        genInterCode(IR_PARAM, newOperand(OP_VARIABLE, internName(interCodeList->names, temp->name)));
         temp = temp->tail;
     }
 }
@@ -681,11 +914,11 @@ void translateCompSt(pNode node) {
     if (interError) return;
     // CompSt -> LC DefList StmtList RC
     pNode temp = node->child->sibling;
-    if (!strcmp(temp->name, "DefList")) {
+    if (temp->name == N_DefList) {
         translateDefList(temp);
         temp = temp->sibling;
     }
-    if (!strcmp(temp->name, "StmtList"))
+    if (temp->name == N_StmtList)
         translateStmtList(temp);
 }
 
@@ -746,13 +979,13 @@ void translateVarDec(pNode node, pOperand place) {
     // VarDec -> ID
     //         | VarDec LB INT RB
 
-    if (!strcmp(node->child->name, "ID")) {
-        pItem temp = searchTableItem(table, node->child->val);
+    if (node->child->name == N_ID) {
+        pItem temp = node->child->item;
         pType type = temp->field->type;
         if (type->kind == BASIC) {
             if (place) {
                 interCodeList->tempVarNum--;
-                setOperand(place, OP_VARIABLE, (void*)newString(temp->field->name));
+                setOperand(place, OP_VARIABLE, (void*)internName(interCodeList->names, temp->field->name));
             }
         } 
         else if (type->kind == ARRAY) {
@@ -767,14 +1000,14 @@ void translateVarDec(pNode node, pOperand place) {
             else {
                 genInterCode(
                     IR_DEC,
-                    newOperand(OP_VARIABLE, newString(temp->field->name)),
+                    newOperand(OP_VARIABLE, internName(interCodeList->names, temp->field->name)),
                     getSize(type));
             }
         } 
         else if (type->kind == STRUCTURE) {
             // 3.1
             genInterCode(IR_DEC,
-                         newOperand(OP_VARIABLE, newString(temp->field->name)),
+                         newOperand(OP_VARIABLE, internName(interCodeList->names, temp->field->name)),
                          getSize(type));
         }
     } 
@@ -802,56 +1035,67 @@ void translateStmt(pNode node) {
     //       | IF LP Exp RP Stmt ELSE Stmt
     //       | WHILE LP Exp RP Stmt
 
-    // Stmt -> Exp SEMI
-    if (!strcmp(node->child->name, "Exp"))
-        translateExp(node->child, NULL);
+    switch (node->prod) {
+        // Stmt -> Exp SEMI
+        case P_STMT_EXP:
+            translateExp(node->child, NULL);
+            break;
 
-    // Stmt -> CompSt
-    else if (!strcmp(node->child->name, "CompSt"))
-        translateCompSt(node->child);
+        // Stmt -> CompSt
+        case P_STMT_COMPST:
+            translateCompSt(node->child);
+            break;
 
-    // Stmt -> RETURN Exp SEMI
-    else if (!strcmp(node->child->name, "RETURN")) {
-        pOperand t1 = newTemp();
-        translateExp(node->child->sibling, t1);
-        genInterCode(IR_RETURN, t1);
-    }
+        // Stmt -> RETURN Exp SEMI
+        case P_STMT_RETURN: {
+            pOperand t1 = newTemp();
+            translateExp(node->child->sibling, t1);
+            genInterCode(IR_RETURN, t1);
+            break;
+        }
 
-    // Stmt -> IF LP Exp RP Stmt
-    else if (!strcmp(node->child->name, "IF")) {
-        pNode exp = node->child->sibling->sibling;
-        pNode stmt = exp->sibling->sibling;
-        pOperand label1 = newLabel();
-        pOperand label2 = newLabel();
-
-        translateCond(exp, label1, label2);
-        genInterCode(IR_LABEL, label1);
-        translateStmt(stmt);
-        if (stmt->sibling == NULL) 
-            genInterCode(IR_LABEL, label2);
-        // Stmt -> IF LP Exp RP Stmt ELSE Stmt
-        else {
+        // Stmt -> IF LP Exp RP Stmt
+        //       | IF LP Exp RP Stmt ELSE Stmt
+        case P_STMT_IF:
+        case P_STMT_IF_ELSE: {
+            pNode exp = node->child->sibling->sibling;
+            pNode stmt = exp->sibling->sibling;
+            pOperand label1 = newLabel();
+            pOperand label2 = newLabel();
+
+            translateCond(exp, label1, label2);
+            genInterCode(IR_LABEL, label1);
+            translateStmt(stmt);
+            if (node->prod == P_STMT_IF) 
+                genInterCode(IR_LABEL, label2);
+            // Stmt -> IF LP Exp RP Stmt ELSE Stmt
+            else {
+                pOperand label3 = newLabel();
+                genInterCode(IR_GOTO, label3);
+                genInterCode(IR_LABEL, label2);
+                translateStmt(stmt->sibling->sibling);
+                genInterCode(IR_LABEL, label3);
+            }
+            break;
+        }
+
+        // Stmt -> WHILE LP Exp RP Stmt
+        case P_STMT_WHILE: {
+            pOperand label1 = newLabel();
+            pOperand label2 = newLabel();
             pOperand label3 = newLabel();
-            genInterCode(IR_GOTO, label3);
+
+            genInterCode(IR_LABEL, label1);
+            translateCond(node->child->sibling->sibling, label2, label3);
             genInterCode(IR_LABEL, label2);
-            translateStmt(stmt->sibling->sibling);
+            translateStmt(node->child->sibling->sibling->sibling->sibling);
+            genInterCode(IR_GOTO, label1);
             genInterCode(IR_LABEL, label3);
+            break;
         }
 
-    }
-
-    // Stmt -> WHILE LP Exp RP Stmt
-    else if (!strcmp(node->child->name, "WHILE")) {
-        pOperand label1 = newLabel();
-        pOperand label2 = newLabel();
-        pOperand label3 = newLabel();
-
-        genInterCode(IR_LABEL, label1);
-        translateCond(node->child->sibling->sibling, label2, label3);
-        genInterCode(IR_LABEL, label2);
-        translateStmt(node->child->sibling->sibling->sibling->sibling);
-        genInterCode(IR_GOTO, label1);
-        genInterCode(IR_LABEL, label3);
+        default:
+            assert(0);
     }
 }
 
@@ -866,7 +1110,7 @@ void translateExp(pNode node, pOperand place) {
     //      | Exp MINUS Exp
     //      | Exp STAR Exp
     //      | Exp DIV Exp
-
+    //      | LP Exp RP
     //      | MINUS Exp
     //      | NOT Exp
     //      | ID LP Args RP
@@ -877,182 +1121,166 @@ void translateExp(pNode node, pOperand place) {
     //      | INT
     //      | FLOAT
 
-    // Exp -> LP Exp RP
-    if (!strcmp(node->child->name, "LP"))
-        translateExp(node->child->sibling, place);
-
-    else if (!strcmp(node->child->name, "Exp") || !strcmp(node->child->name, "NOT")) {
-        if (strcmp(node->child->sibling->name, "LB") && strcmp(node->child->sibling->name, "DOT")) {
-            // Exp -> Exp AND Exp
-            //      | Exp OR Exp
-            //      | Exp RELOP Exp
-            //      | NOT Exp
-            if (!strcmp(node->child->sibling->name, "AND") ||
-                !strcmp(node->child->sibling->name, "OR") ||
-                !strcmp(node->child->sibling->name, "RELOP") ||
-                !strcmp(node->child->name, "NOT")) {
-                pOperand label1 = newLabel();
-                pOperand label2 = newLabel();
-                pOperand true_num = newOperand(OP_CONSTANT, 1);
-                pOperand false_num = newOperand(OP_CONSTANT, 0);
-                genInterCode(IR_ASSIGN, place, false_num);
-                translateCond(node, label1, label2);
-                genInterCode(IR_LABEL, label1);
-                genInterCode(IR_ASSIGN, place, true_num);
-            } 
-            else {
-                // Exp -> Exp ASSIGNOP Exp
-                if (!strcmp(node->child->sibling->name, "ASSIGNOP")) {
-                    pOperand t2 = newTemp();
-                    translateExp(node->child->sibling->sibling, t2);
-                    pOperand t1 = newTemp();
-                    translateExp(node->child, t1);
-                    genInterCode(IR_ASSIGN, t1, t2);
-                } 
-                else {
-                    pOperand t1 = newTemp();
-                    translateExp(node->child, t1);
-                    pOperand t2 = newTemp();
-                    translateExp(node->child->sibling->sibling, t2);
-                    // Exp -> Exp PLUS Exp
-                    if (!strcmp(node->child->sibling->name, "PLUS"))
-                        genInterCode(IR_ADD, place, t1, t2);
-                    // Exp -> Exp MINUS Exp
-                    else if (!strcmp(node->child->sibling->name, "MINUS"))
-                        genInterCode(IR_SUB, place, t1, t2);
-                    // Exp -> Exp STAR Exp
-                    else if (!strcmp(node->child->sibling->name, "STAR"))
-                        genInterCode(IR_MUL, place, t1, t2);
-                    // Exp -> Exp DIV Exp
-                    else if (!strcmp(node->child->sibling->name, "DIV"))
-                        genInterCode(IR_DIV, place, t1, t2);
-                }
-            }
+    switch (node->prod) {
+        // Exp -> LP Exp RP
+        case P_EXP_PAREN:
+            translateExp(node->child->sibling, place);
+            break;
 
+        // Exp -> Exp AND Exp
+        //      | Exp OR Exp
+        //      | Exp RELOP Exp
+        //      | NOT Exp
+        case P_EXP_AND:
+        case P_EXP_OR:
+        case P_EXP_RELOP:
+        case P_EXP_NOT: {
+            pOperand label1 = newLabel();
+            pOperand label2 = newLabel();
+            pOperand true_num = newOperand(OP_CONSTANT, 1);
+            pOperand false_num = newOperand(OP_CONSTANT, 0);
+            genInterCode(IR_ASSIGN, place, false_num);
+            translateCond(node, label1, label2);
+            genInterCode(IR_LABEL, label1);
+            genInterCode(IR_ASSIGN, place, true_num);
+            genInterCode(IR_LABEL, label2);
+            break;
         }
-        else {
-            // Exp -> Exp LB Exp RB
-            if (!strcmp(node->child->sibling->name, "LB")) {
-                if (node->child->child->sibling && !strcmp(node->child->child->sibling, "LB")) {
-                    interError = TRUE;
-                    printf(
-                        "Cannot translate: Code containsvariables of "
-                        "multi-dimensional array type or parameters of array "
-                        "type.\n");
-                    return;
-                } 
-                else {
-                    pOperand idx = newTemp();
-                    translateExp(node->child->sibling->sibling, idx);
-                    pOperand base = newTemp();
-                    translateExp(node->child, base);
-
-                    pOperand width;
-                    pOperand offset = newTemp();
-                    pOperand target;
-                    // 根据假设，Exp1只会展开为 Exp DOT ID 或 ID
-                    // 我们让前一种情况吧ID作为name回填进place返回到这里的base处，在语义分析时将结构体变量也填进表（因为假设无重名），这样两种情况都可以查表得到。
-                    pItem item = searchTableItem(table, base->u.name);
-                    assert(item->field->type->kind == ARRAY);
-                    width = newOperand(OP_CONSTANT, getSize(item->field->type->u.array.elem));
-                    genInterCode(IR_MUL, offset, idx, width);
-                    // 如果是ID[Exp],
-                    // 则需要对ID取址，如果前面是结构体内访问，则会返回一个地址类型，不需要再取址
-                    if (base->kind == OP_VARIABLE) {
-                        // printf("非结构体数组访问\n");
-                        target = newTemp();
-                        genInterCode(IR_GET_ADDR, target, base);
-                    } 
-                    else
-                        // printf("结构体数组访问\n");
-                        target = base;
-                    genInterCode(IR_ADD, place, target, offset);
-                    place->kind = OP_ADDRESS;
-                    interCodeList->lastArrayName = base->u.name;
-                }
+
+        // Exp -> Exp ASSIGNOP Exp
+        case P_EXP_ASSIGNOP: {
+            pOperand t2 = newTemp();
+            translateExp(node->child->sibling->sibling, t2);
+            pOperand t1 = newTemp();
+            translateExp(node->child, t1);
+            genInterCode(IR_ASSIGN, t1, t2);
+            break;
+        }
+
+        // Exp -> Exp PLUS Exp
+        //      | Exp MINUS Exp
+        //      | Exp STAR Exp
+        //      | Exp DIV Exp
+        case P_EXP_PLUS:
+        case P_EXP_MINUS:
+        case P_EXP_STAR:
+        case P_EXP_DIV: {
+            static const int arithCode[] = {
+                [P_EXP_PLUS] = IR_ADD,
+                [P_EXP_MINUS] = IR_SUB,
+                [P_EXP_STAR] = IR_MUL,
+                [P_EXP_DIV] = IR_DIV,
+            };
+            pOperand t1 = newTemp();
+            translateExp(node->child, t1);
+            pOperand t2 = newTemp();
+            translateExp(node->child->sibling->sibling, t2);
+            genInterCode(arithCode[node->prod], place, t1, t2);
+            break;
+        }
+
+        // Exp -> Exp LB Exp RB
+        case P_EXP_INDEX: {
+            if (node->child->prod == P_EXP_INDEX) {
+                interError = TRUE;
+                printf(
+                    "Cannot translate: Code containsvariables of "
+                    "multi-dimensional array type or parameters of array "
+                    "type.\n");
+                return;
+            } 
+            pOperand idx = newTemp();
+            translateExp(node->child->sibling->sibling, idx);
+            pOperand base = newTemp();
+            translateExp(node->child, base);
+
+            pOperand width;
+            pOperand offset = newTemp();
+            pOperand target;
+            // 根据假设，Exp1只会展开为 Exp DOT ID 或 ID
+            // 我们让前一种情况吧ID作为name回填进place返回到这里的base处，在语义分析时将结构体变量也填进表（因为假设无重名），这样两种情况都可以查表得到。
+            pItem item = getExpItem(node->child);
+            assert(item->field->type->kind == ARRAY);
+            width = newOperand(OP_CONSTANT, getSize(item->field->type->u.array.elem));
+            genInterCode(IR_MUL, offset, idx, width);
+            // 如果是ID[Exp],
+            // 则需要对ID取址，如果前面是结构体内访问，则会返回一个地址类型，不需要再取址
+            if (base->kind == OP_VARIABLE) {
+                // printf("非结构体数组访问\n");
+                target = newTemp();
+                genInterCode(IR_GET_ADDR, target, base);
+            } 
+            else
+                // printf("结构体数组访问\n");
+                target = base;
+            genInterCode(IR_ADD, place, target, offset);
+            place->kind = OP_ADDRESS;
+            break;
+        }
+
+        // Exp -> Exp DOT ID
+        case P_EXP_FIELD: {
+            pOperand temp = newTemp();
+            translateExp(node->child, temp);
+            // 两种情况，Exp直接为一个变量，则需要先取址，若Exp为数组或者多层结构体访问或结构体形参，则target会被填成地址，可以直接用。
+
+            char* id = node->child->sibling->sibling->val;
+            pItem item = getExpItem(node->child);
+            //结构体数组，temp是临时变量，没有符号，用数组名的符号
+            if (item == NULL && node->child->prod == P_EXP_INDEX)
+                item = getExpItem(node->child->child);
+
+            pOperand target = newTemp();
+            // a[i] 已经算出元素地址，地址本身就是结构体的基址，不再读取
+            if (temp->kind == OP_ADDRESS) {
+                temp->kind = OP_VARIABLE;
+                target = temp;
+            }
+            else if (item->field->isArg && item->field->type->kind == STRUCTURE)
+                target = temp;
+            else
+                genInterCode(IR_GET_ADDR, target, temp);
+
+            pType structType;
+            // 结构体数组 eg: a[5].b
+            if (item->field->type->kind == ARRAY)
+                structType = item->field->type->u.array.elem;
+            // 一般结构体
+            else 
+                structType = item->field->type;
+            // offset在结构体定义时已算好，非结构体和找不到的域语义分析已经报错
+            int offset = 0;
+            if (structType->kind == STRUCTURE) {
+                pFieldList field = findField(structType, id);
+                offset = field ? field->offset : getSize(structType);
             }
-            // Exp -> Exp DOT ID
-            else {
-                pOperand temp = newTemp();
-                translateExp(node->child, temp);
-                // 两种情况，Exp直接为一个变量，则需要先取址，若Exp为数组或者多层结构体访问或结构体形参，则target会被填成地址，可以直接用。
-
-                pOperand id = newOperand(OP_VARIABLE, newString(node->child->sibling->sibling->val));
-                int offset = 0;
-                pItem item = searchTableItem(table, temp->u.name);
-                
-                pOperand target = newTemp();
-                if (item->field->isArg && item->field->type->kind == STRUCTURE)
-                    target = temp;
-                else
-                    genInterCode(IR_GET_ADDR, target, temp);
-                
-                //结构体数组，temp是临时变量，查不到表，需要用处理数组时候记录下的数组名老查表
-                if (item == NULL)
-                    item = searchTableItem(table, interCodeList->lastArrayName);
-
-                pFieldList tmp;
-                // 结构体数组 eg: a[5].b
-                if (item->field->type->kind == ARRAY)
-                    tmp = item->field->type->u.array.elem->u.structure.field;
-                // 一般结构体
-                else 
-                    tmp = item->field->type->u.structure.field;
-                // 遍历获得offset
-                while (tmp) {
-                    if (!strcmp(tmp->name, id->u.name)) break;
-                    offset += getSize(tmp->type);
-                    tmp = tmp->tail;
-                }
 
-                pOperand tOffset = newOperand(OP_CONSTANT, offset);
-                if (place) {
-                    genInterCode(IR_ADD, place, target, tOffset);
-                    setOperand(place, OP_ADDRESS, (void*)newString(place->u.name));
-                }
+            pOperand tOffset = newOperand(OP_CONSTANT, offset);
+            if (place) {
+                genInterCode(IR_ADD, place, target, tOffset);
+                place->kind = OP_ADDRESS;
             }
+            break;
         }
-    }
 
-    // Exp -> MINUS Exp
-    else if (!strcmp(node->child->name, "MINUS")) {
-        pOperand t1 = newTemp();
-        translateExp(node->child->sibling, t1);
-        pOperand zero = newOperand(OP_CONSTANT, 0);
-        genInterCode(IR_SUB, place, zero, t1);
-    }
-    // Exp -> NOT Exp
+        // Exp -> MINUS Exp
+        case P_EXP_NEG: {
+            pOperand t1 = newTemp();
+            translateExp(node->child->sibling, t1);
+            pOperand zero = newOperand(OP_CONSTANT, 0);
+            genInterCode(IR_SUB, place, zero, t1);
+            break;
+        }
 
-    // Exp -> ID LP Args RP
-    //		| ID LP RP
-    else if (!strcmp(node->child->name, "ID") && node->child->sibling) {
-        pOperand funcTemp = newOperand(OP_FUNCTION, newString(node->child->val));
         // Exp -> ID LP Args RP
-        if (!strcmp(node->child->sibling->sibling->name, "Args")) {
+        case P_EXP_CALL_ARGS: {
+            pOperand funcTemp = newOperand(OP_FUNCTION, internName(interCodeList->names, node->child->val));
             pArgList argList = newArgList();
             translateArgs(node->child->sibling->sibling, argList);
             if (!strcmp(node->child->val, "write"))
                 genInterCode(IR_WRITE, argList->head->op);
             else {
-                pArg argTemp = argList->head;
-                while (argTemp) {
-                    if (argTemp->op->kind == OP_VARIABLE) {
-                        pItem item = searchTableItem(table, argTemp->op->u.name);
-
-                        // 结构体作为参数需要传址
-                        if (item && item->field->type->kind == STRUCTURE) {
-                            pOperand varTemp = newTemp();
-                            genInterCode(IR_GET_ADDR, varTemp, argTemp->op);
-                            genInterCode(IR_ARG, varTemp);
-                        }
-                        
-                        // 一般参数直接传值
-                        else
-                            genInterCode(IR_ARG, argTemp->op);
-                    }
-                    
-                    argTemp = argTemp->next;
-                }
+                translateArgList(argList->head);
                 if (place)
                     genInterCode(IR_CALL, place, funcTemp);
                 else {
@@ -1060,9 +1288,13 @@ void translateExp(pNode node, pOperand place) {
                     genInterCode(IR_CALL, temp, funcTemp);
                 }
             }
+            deleteArgList(argList);
+            break;
         }
+
         // Exp -> ID LP RP
-        else {
+        case P_EXP_CALL: {
+            pOperand funcTemp = newOperand(OP_FUNCTION, internName(interCodeList->names, node->child->val));
             if (!strcmp(node->child->val, "read"))
                 genInterCode(IR_READ, place);
             else {
@@ -1073,19 +1305,24 @@ void translateExp(pNode node, pOperand place) {
                     genInterCode(IR_CALL, temp, funcTemp);
                 }
             }
+            break;
         }
-    }
-    // Exp -> ID
-    else if (!strcmp(node->child->name, "ID")) {
-        pItem item = searchTableItem(table, node->child->val);
-        setOperand(place, OP_VARIABLE, (void*)newString(node->child->val));
-    } 
-    else {
+
+        // Exp -> ID
+        case P_EXP_ID:
+            setOperand(place, OP_VARIABLE, (void*)internName(interCodeList->names, node->child->val));
+            break;
+
         // Exp -> FLOAT
+        //      | INT
+        case P_EXP_FLOAT:
+        case P_EXP_INT:
+            interCodeList->tempVarNum--;
+            setOperand(place, OP_CONSTANT, (void*)(long)atoi(node->child->val));
+            break;
 
-        // Exp -> INT
-        interCodeList->tempVarNum--;
-        setOperand(place, OP_CONSTANT, (void*)atoi(node->child->val));
+        default:
+            assert(0);
     }
 }
 
@@ -1097,70 +1334,93 @@ void translateCond(pNode node, pOperand labelTrue, pOperand labelFalse) {
     //      | Exp RELOP Exp
     //      | NOT Exp
 
-    // Exp -> NOT Exp
-    if (!strcmp(node->child->name, "NOT")) {
-        translateCond(node->child->sibling, labelFalse, labelTrue);
-    }
-    
-    // Exp -> Exp RELOP Exp
-    else if (!strcmp(node->child->sibling->name, "RELOP")) {
-        pOperand t1 = newTemp();
-        pOperand t2 = newTemp();
-        translateExp(node->child, t1);
-        translateExp(node->child->sibling->sibling, t2);
+    switch (node->prod) {
+        // Exp -> NOT Exp
+        case P_EXP_NOT:
+            translateCond(node->child->sibling, labelFalse, labelTrue);
+            break;
 
-        pOperand relop = newOperand(OP_RELOP, newString(node->child->sibling->val));
+        // Exp -> Exp RELOP Exp
+        case P_EXP_RELOP: {
+            pOperand t1 = newTemp();
+            pOperand t2 = newTemp();
+            translateExp(node->child, t1);
+            translateExp(node->child->sibling->sibling, t2);
 
-        if (t1->kind == OP_ADDRESS) {
-            pOperand temp = newTemp();
-            genInterCode(IR_READ_ADDR, temp, t1);
-            t1 = temp;
+            pOperand relop = newOperand(OP_RELOP, internName(interCodeList->names, node->child->sibling->val));
+
+            if (t1->kind == OP_ADDRESS) {
+                pOperand temp = newTemp();
+                genInterCode(IR_READ_ADDR, temp, t1);
+                t1 = temp;
+            }
+            
+            if (t2->kind == OP_ADDRESS) {
+                pOperand temp = newTemp();
+                genInterCode(IR_READ_ADDR, temp, t2);
+                t2 = temp;
+            }
+
+            genInterCode(IR_IF_GOTO, t1, relop, t2, labelTrue);
+            genInterCode(IR_GOTO, labelFalse);
+            break;
         }
-        
-        if (t2->kind == OP_ADDRESS) {
-            pOperand temp = newTemp();
-            genInterCode(IR_READ_ADDR, temp, t2);
-            t2 = temp;
+
+        // Exp -> Exp AND Exp
+        case P_EXP_AND: {
+            pOperand label1 = newLabel();
+            translateCond(node->child, label1, labelFalse);
+            genInterCode(IR_LABEL, label1);
+            translateCond(node->child->sibling->sibling, labelTrue, labelFalse);
+            break;
         }
 
-        genInterCode(IR_IF_GOTO, t1, relop, t2, labelTrue);
-        genInterCode(IR_GOTO, labelFalse);
-    }
-    
-    // Exp -> Exp AND Exp
-    else if (!strcmp(node->child->sibling->name, "AND")) {
-        pOperand label1 = newLabel();
-        translateCond(node->child, label1, labelFalse);
-        genInterCode(IR_LABEL, label1);
-        translateCond(node->child->sibling->sibling, labelTrue, labelFalse);
-    }
-    
-    // Exp -> Exp OR Exp
-    else if (!strcmp(node->child->sibling->name, "OR")) {
-        pOperand label1 = newLabel();
-        translateCond(node->child, labelTrue, label1);
-        genInterCode(IR_LABEL, label1);
-        translateCond(node->child->sibling->sibling, labelTrue, labelFalse);
-    }
-    
-    // other cases
-    else {
-        pOperand t1 = newTemp();
-        translateExp(node, t1);
-        pOperand t2 = newOperand(OP_CONSTANT, 0);
-        pOperand relop = newOperand(OP_RELOP, newString("!="));
+        // Exp -> Exp OR Exp
+        case P_EXP_OR: {
+            pOperand label1 = newLabel();
+            translateCond(node->child, labelTrue, label1);
+            genInterCode(IR_LABEL, label1);
+            translateCond(node->child->sibling->sibling, labelTrue, labelFalse);
+            break;
+        }
 
-        if (t1->kind == OP_ADDRESS) {
-            pOperand temp = newTemp();
-            genInterCode(IR_READ_ADDR, temp, t1);
-            t1 = temp;
+        // other cases
+        default: {
+            pOperand t1 = newTemp();
+            translateExp(node, t1);
+            pOperand t2 = newOperand(OP_CONSTANT, 0);
+            pOperand relop = newOperand(OP_RELOP, internName(interCodeList->names, "!="));
+
+            if (t1->kind == OP_ADDRESS) {
+                pOperand temp = newTemp();
+                genInterCode(IR_READ_ADDR, temp, t1);
+                t1 = temp;
+            }
+            
+            genInterCode(IR_IF_GOTO, t1, relop, t2, labelTrue);
+            genInterCode(IR_GOTO, labelFalse);
         }
-        
-        genInterCode(IR_IF_GOTO, t1, relop, t2, labelTrue);
-        genInterCode(IR_GOTO, labelFalse);
     }
 }
 
+// ARGs are emitted last argument first, so the ARG right before CALL is the first PARAM
+void translateArgList(pArg arg) {
+    if (arg == NULL) return;
+    translateArgList(arg->next);
+    pItem item = arg->op->kind == OP_VARIABLE ? arg->item : NULL;
+
+    // 结构体作为参数需要传址
+    if (item && item->field->type->kind == STRUCTURE) {
+        pOperand varTemp = newTemp();
+        genInterCode(IR_GET_ADDR, varTemp, arg->op);
+        genInterCode(IR_ARG, varTemp);
+    }
+
+    // 一般参数直接传值，常量和地址也要传
+    else
+        genInterCode(IR_ARG, arg->op);
+}
+
 void translateArgs(pNode node, pArgList argList) {
     assert(node != NULL);
     assert(argList != NULL);
@@ -1171,9 +1431,10 @@ void translateArgs(pNode node, pArgList argList) {
     // Args -> Exp
     pArg temp = newArg(newTemp());
     translateExp(node->child, temp->op);
+    temp->item = getExpItem(node->child);
 
     if (temp->op->kind == OP_VARIABLE) {
-        pItem item = searchTableItem(table, temp->op->u.name);
+        pItem item = temp->item;
         if (item && item->field->type->kind == ARRAY) {
             interError = TRUE;
             printf(
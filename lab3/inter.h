@@ -5,11 +5,19 @@
 
 typedef struct operand* pOperand;
 typedef struct interCode* pInterCode;
-typedef struct interCodes* pInterCodes;
 typedef struct arg* pArg;
 typedef struct argList* pArgList;
+typedef struct nameTable* pNameTable;
+typedef struct outBuffer* pOutBuffer;
 typedef struct interCodeList* pInterCodeList;
 
+#define NAME_TABLE_INIT_SIZE 0x100
+#define OPERAND_BLOCK_SHIFT 10
+#define OPERAND_BLOCK_SIZE (1 << OPERAND_BLOCK_SHIFT)
+#define INTER_CODE_INIT_SIZE 0x400
+#define OUT_BUFFER_SIZE 0x10000
+#define IR_BINARY_MAGIC "CIR\1"
+
 typedef struct operand {
     enum {
         OP_VARIABLE,
@@ -20,9 +28,12 @@ typedef struct operand {
         OP_RELOP,
     } kind;
 
+    // temporaries and labels are numbered and printed as t<no> / label<no>, everything else has no == 0
+    int no;
+    int index;          // slot in the interCodeList operand pool, codes refer to operands by it
     union {
         int value;
-        char* name;
+        char* name;     // interned, compare by pointer
     } u;
 } Operand;
 
@@ -47,35 +58,34 @@ typedef struct interCode {
         IR_PARAM,
         IR_READ,
         IR_WRITE,
+        IR_NOP,         // erased by a pass, dropped by compactInterCodes
     } kind;
 
+    // operand indices into the interCodeList pool, 0 is no operand
     union {
         struct {
-            pOperand op;
+            int op;
         } oneOp;
         struct {
-            pOperand right, left;
+            int right, left;
         } assign;
         struct {
-            pOperand result, op1, op2;
+            int result, op1, op2;
         } binOp;
         struct {
-            pOperand x, relop, y, z;
+            int x, relop, y, z;
         } ifGoto;
         struct {
-            pOperand op;
+            int op;
             int size;
         } dec;
+        int ops[4];
     } u;
 } InterCode;
 
-typedef struct interCodes {
-    pInterCode code;
-    pInterCodes *prev, *next;
-} InterCodes;
-
 typedef struct arg {
     pOperand op;
+    pItem item;         // symbol of an ID argument, struct arguments are passed by address
     pArg next;
 } Arg;
 
@@ -84,10 +94,33 @@ typedef struct argList {
     pArg cur;
 } ArgList;
 
+// output is formatted into buf and written with one fwrite per OUT_BUFFER_SIZE bytes,
+// with fp == NULL nothing is written and buf grows to hold the whole output
+typedef struct outBuffer {
+    FILE* fp;
+    char* buf;
+    size_t len;
+    size_t size;
+} OutBuffer;
+
+// interns variable, function and relop names so equal names share one pointer
+typedef struct nameTable {
+    char** names;
+    unsigned size;      // always a power of 2
+    unsigned count;
+    pArena arena;
+} NameTable;
+
+// codes live in one growable array, operands in fixed blocks so a pOperand stays valid while the pool grows
 typedef struct interCodeList {
-    pInterCodes head;
-    pInterCodes cur;
-    char* lastArrayName;
+    pInterCode codes;
+    int count;
+    int capacity;
+    pOperand* opBlocks;
+    int opCount;
+    int opBlockNum;
+    pNameTable names;
+    int varBase;        // first variable key of named variables, see updateVarKeys
     int tempVarNum;
     int labelNum;
 } InterCodeList;
@@ -95,20 +128,67 @@ typedef struct interCodeList {
 extern boolean interError;
 extern pInterCodeList interCodeList;
 
+// OutBuffer func
+pOutBuffer newOutBuffer(FILE* fp);
+void deleteOutBuffer(pOutBuffer p);
+void flushOutBuffer(pOutBuffer p);
+void reserveOutBuffer(pOutBuffer p, size_t n);
+
+static inline void putChar(pOutBuffer p, char c) {
+    if (p->len == p->size)
+        reserveOutBuffer(p, 1);
+    p->buf[p->len++] = c;
+}
+
+static inline void putBytes(pOutBuffer p, const char* s, size_t n) {
+    if (p->size - p->len < n)
+        reserveOutBuffer(p, n);
+    memcpy(p->buf + p->len, s, n);
+    p->len += n;
+}
+
+static inline void putString(pOutBuffer p, const char* s) {
+    putBytes(p, s, strlen(s));
+}
+
+static inline void putInt(pOutBuffer p, int val) {
+    char tmp[12];
+    char* c = tmp + sizeof(tmp);
+    unsigned u = val < 0 ? -(unsigned)val : (unsigned)val;
+    do {
+        *--c = '0' + u % 10;
+        u /= 10;
+    } while (u);
+    if (val < 0)
+        *--c = '-';
+    putBytes(p, c, tmp + sizeof(tmp) - c);
+}
+
+// NameTable func
+pNameTable newNameTable(unsigned size);
+void deleteNameTable(pNameTable p);
+char* internName(pNameTable p, char* name);
+int getNameIndex(pNameTable p, char* name);
+
 // Operand func
+pOperand allocOperand(pInterCodeList interCodeList);
 pOperand newOperand(int kind, ...);
+int newConstant(pInterCodeList interCodeList, int value);
+int updateVarKeys(pInterCodeList interCodeList);
+int getVarKey(pInterCodeList interCodeList, int index);
 void setOperand(pOperand p, int kind, void* val);
-void deleteOperand(pOperand p);
-void printOp(FILE* fp, pOperand op);
+pItem getExpItem(pNode node);
+void printOp(pOutBuffer out, pOperand op);
 
 // InterCode func
-pInterCode newInterCode(int kind, ...);
-void deleteInterCode(pInterCode p);
+InterCode newInterCode(int kind, ...);
+int* getCodeDefSlot(pInterCode code);
+int getCodeDef(pInterCode code);
+int getCodeUses(pInterCode code, int* uses[3]);
+void emitCode(pOutBuffer out, pInterCodeList interCodeList, pInterCode code);
+void emitInterCode(pOutBuffer out, pInterCodeList interCodeList);
 void printInterCode(FILE* fp, pInterCodeList interCodeList);
-
-// InterCodes func
-pInterCodes newInterCodes(pInterCode code);
-void deleteInterCodes(pInterCodes p);
+char* printInterCodeToBuffer(pInterCodeList interCodeList, size_t* len);
 
 // Arg and ArgList func
 pArg newArg(pOperand op);
@@ -120,16 +200,32 @@ void addArg(pArgList argList, pArg arg);
 // InterCodeList func
 pInterCodeList newInterCodeList();
 void deleteInterCodeList(pInterCodeList p);
-void addInterCode(pInterCodeList interCodeList, pInterCodes newCode);
+void clearInterCodeList(pInterCodeList p);
+void shiftInterCodeNumbers(pInterCodeList p, int tempBase, int labelBase);
+void addInterCode(pInterCodeList interCodeList, InterCode newCode);
+void insertInterCode(pInterCodeList interCodeList, int pos, InterCode newCode);
+void eraseInterCode(pInterCodeList interCodeList, int pos);
+void compactInterCodes(pInterCodeList interCodeList);
+
+// binary IR func
+void writeInterCode(FILE* fp, pInterCodeList interCodeList);
+pInterCodeList readInterCode(FILE* fp);
+
+static inline pOperand getOperand(pInterCodeList interCodeList, int index) {
+    assert(index > 0 && index < interCodeList->opCount);
+    return interCodeList->opBlocks[index >> OPERAND_BLOCK_SHIFT] + (index & (OPERAND_BLOCK_SIZE - 1));
+}
 
 // traverse func
 pOperand newTemp();
 pOperand newLabel();
 int getSize(pType type);
 void genInterCodes(pNode node);
+void checkAndGenInterCodes(pNode node);
 void genInterCode(int kind, ...);
 void translateExp(pNode node, pOperand place);
 void translateArgs(pNode node, pArgList argList);
+void translateArgList(pArg arg);
 void translateCond(pNode node, pOperand labelTrue, pOperand labelFalse);
 void translateVarDec(pNode node, pOperand place);
 void translateDec(pNode node);
@@ -0,0 +1,474 @@
+#include <time.h>
+#include "interp.h"
+
+// InterpProgram func
+typedef struct interpLoader {
+    pInterCodeList list;
+    pInterpProgram prog;
+    int capacity;
+    int curFunc;
+    int frameCapacity;
+    // which function owns a temp / name / constant operand and its frame offset there
+    int *tempOwner, *tempOff;
+    int *nameOwner, *nameOff;
+    int *constOwner, *constOff;
+} InterpLoader;
+
+static int allocSlot(InterpLoader* l, int size) {
+    pInterpFunc f = &l->prog->funcs[l->curFunc];
+    if (f->frameSize + size > l->frameCapacity) {
+        while (f->frameSize + size > l->frameCapacity)
+            l->frameCapacity *= 2;
+        f->frame = (int*)realloc(f->frame, sizeof(int) * l->frameCapacity);
+        assert(f->frame != NULL);
+    }
+    memset(f->frame + f->frameSize, 0, sizeof(int) * size);
+    f->frameSize += size;
+    return f->frameSize - size;
+}
+
+static int getSlot(InterpLoader* l, int index) {
+    pOperand op = getOperand(l->list, index);
+    if (op->kind == OP_CONSTANT) {
+        if (l->constOwner[index] != l->curFunc) {
+            l->constOwner[index] = l->curFunc;
+            l->constOff[index] = allocSlot(l, 1);
+            l->prog->funcs[l->curFunc].frame[l->constOff[index]] = op->u.value;
+        }
+        return l->constOff[index];
+    }
+    if (op->no != 0) {
+        if (l->tempOwner[op->no] != l->curFunc) {
+            l->tempOwner[op->no] = l->curFunc;
+            l->tempOff[op->no] = allocSlot(l, 1);
+        }
+        return l->tempOff[op->no];
+    }
+    int slot = getNameIndex(l->list->names, op->u.name);
+    assert(slot >= 0);
+    if (l->nameOwner[slot] != l->curFunc) {
+        l->nameOwner[slot] = l->curFunc;
+        l->nameOff[slot] = allocSlot(l, 1);
+    }
+    return l->nameOff[slot];
+}
+
+static void addCode(InterpLoader* l, InterpOpcode op, int a, int b, int c) {
+    pInterpProgram p = l->prog;
+    if (p->count == l->capacity) {
+        l->capacity *= 2;
+        p->codes = (pInterpCode)realloc(p->codes, sizeof(InterpCode) * l->capacity);
+        assert(p->codes != NULL);
+    }
+    p->codes[p->count++] = (InterpCode){op, a, b, c};
+}
+
+static int* newIntArray(int size, int val) {
+    int* p = (int*)malloc(sizeof(int) * (size > 0 ? size : 1));
+    assert(p != NULL);
+    for (int i = 0; i < size; i++)
+        p[i] = val;
+    return p;
+}
+
+pInterpProgram newInterpProgram(pInterCodeList interCodeList) {
+    assert(interCodeList != NULL);
+    pNameTable names = interCodeList->names;
+    pInterpProgram p = (pInterpProgram)malloc(sizeof(InterpProgram));
+    assert(p != NULL);
+    p->count = 0;
+    p->funcNum = 0;
+    p->mainFunc = -1;
+
+    InterpLoader l = {.list = interCodeList, .prog = p, .capacity = interCodeList->count + 1, .curFunc = -1};
+    p->codes = (pInterpCode)malloc(sizeof(InterpCode) * l.capacity);
+    assert(p->codes != NULL);
+    // tempVarNum is no bound on temp numbers, varBase is one past the largest
+    updateVarKeys(interCodeList);
+    l.tempOwner = newIntArray(interCodeList->varBase, -1);
+    l.tempOff = newIntArray(interCodeList->varBase, 0);
+    l.nameOwner = newIntArray(names->size, -1);
+    l.nameOff = newIntArray(names->size, 0);
+    l.constOwner = newIntArray(interCodeList->opCount, -1);
+    l.constOff = newIntArray(interCodeList->opCount, 0);
+    int* funcOfName = newIntArray(names->size, -1);
+    int* labelTarget = newIntArray(interCodeList->labelNum, -1);
+    boolean ok = TRUE;
+
+    // functions are numbered first so that CALLs can refer to later ones
+    for (int i = 0; i < interCodeList->count; i++)
+        if (interCodeList->codes[i].kind == IR_FUNCTION) p->funcNum++;
+    p->funcs = (pInterpFunc)calloc(p->funcNum > 0 ? p->funcNum : 1, sizeof(InterpFunc));
+    assert(p->funcs != NULL);
+    for (int i = 0, n = 0; i < interCodeList->count; i++) {
+        pInterCode cur = &interCodeList->codes[i];
+        if (cur->kind != IR_FUNCTION) continue;
+        char* name = getOperand(interCodeList, cur->u.oneOp.op)->u.name;
+        p->funcs[n].name = name;
+        funcOfName[getNameIndex(names, name)] = n;
+        if (!strcmp(name, "main")) p->mainFunc = n;
+        n++;
+    }
+    if (p->mainFunc < 0) {
+        fprintf(stderr, "Cannot interpret: no function main.\n");
+        ok = FALSE;
+    }
+
+    for (int i = 0; i < interCodeList->count && ok; i++) {
+        pInterCode cur = &interCodeList->codes[i];
+        if (cur->kind == IR_FUNCTION) {
+            if (l.curFunc >= 0)
+                addCode(&l, OPC_END, 0, 0, 0);
+            l.curFunc++;
+            pInterpFunc f = &p->funcs[l.curFunc];
+            l.frameCapacity = 0x10;
+            f->frame = (int*)malloc(sizeof(int) * l.frameCapacity);
+            assert(f->frame != NULL);
+            f->params = (int*)malloc(sizeof(int) * 0x10);
+            assert(f->params != NULL);
+            f->entry = p->count;
+
+            // arrays and structs get their storage before any other slot of the function
+            for (int j = i + 1; j < interCodeList->count && interCodeList->codes[j].kind != IR_FUNCTION; j++) {
+                pInterCode dec = &interCodeList->codes[j];
+                if (dec->kind != IR_DEC) continue;
+                pOperand op = getOperand(interCodeList, dec->u.dec.op);
+                int size = (dec->u.dec.size + 3) / 4;
+                if (op->no != 0) {
+                    l.tempOwner[op->no] = l.curFunc;
+                    l.tempOff[op->no] = allocSlot(&l, size);
+                }
+                else {
+                    int slot = getNameIndex(names, op->u.name);
+                    l.nameOwner[slot] = l.curFunc;
+                    l.nameOff[slot] = allocSlot(&l, size);
+                }
+            }
+            continue;
+        }
+        if (l.curFunc < 0) {
+            fprintf(stderr, "Cannot interpret: code outside of a function.\n");
+            ok = FALSE;
+            break;
+        }
+
+        pInterpFunc f = &p->funcs[l.curFunc];
+        switch (cur->kind) {
+            case IR_LABEL:
+                labelTarget[getOperand(interCodeList, cur->u.oneOp.op)->no] = p->count;
+                break;
+            case IR_PARAM:
+                if ((f->paramNum & (f->paramNum - 1)) == 0 && f->paramNum >= 0x10) {
+                    f->params = (int*)realloc(f->params, sizeof(int) * f->paramNum * 2);
+                    assert(f->params != NULL);
+                }
+                f->params[f->paramNum++] = getSlot(&l, cur->u.oneOp.op);
+                break;
+            case IR_DEC:
+            case IR_NOP:
+                break;
+            case IR_ASSIGN:
+                addCode(&l, OPC_MOV, getSlot(&l, cur->u.assign.left), getSlot(&l, cur->u.assign.right), 0);
+                break;
+            case IR_ADD:
+            case IR_SUB:
+            case IR_MUL:
+            case IR_DIV:
+                addCode(&l, OPC_ADD + (cur->kind - IR_ADD), getSlot(&l, cur->u.binOp.result),
+                        getSlot(&l, cur->u.binOp.op1), getSlot(&l, cur->u.binOp.op2));
+                break;
+            case IR_GET_ADDR:
+                addCode(&l, OPC_ADDR, getSlot(&l, cur->u.assign.left), getSlot(&l, cur->u.assign.right), 0);
+                break;
+            case IR_READ_ADDR:
+                addCode(&l, OPC_LOAD, getSlot(&l, cur->u.assign.left), getSlot(&l, cur->u.assign.right), 0);
+                break;
+            case IR_WRITE_ADDR:
+                addCode(&l, OPC_STORE, getSlot(&l, cur->u.assign.left), getSlot(&l, cur->u.assign.right), 0);
+                break;
+            case IR_GOTO:
+                // targets are still label numbers here, patched below
+                addCode(&l, OPC_GOTO, getOperand(interCodeList, cur->u.oneOp.op)->no, 0, 0);
+                break;
+            case IR_IF_GOTO: {
+                static const char* relops[] = {"==", "!=", "<", ">", "<=", ">="};
+                char* relop = getOperand(interCodeList, cur->u.ifGoto.relop)->u.name;
+                int k = 0;
+                while (k < 6 && strcmp(relops[k], relop)) k++;
+                assert(k < 6);
+                addCode(&l, OPC_IF_EQ + k, getSlot(&l, cur->u.ifGoto.x), getSlot(&l, cur->u.ifGoto.y),
+                        getOperand(interCodeList, cur->u.ifGoto.z)->no);
+                break;
+            }
+            case IR_RETURN:
+                addCode(&l, OPC_RETURN, getSlot(&l, cur->u.oneOp.op), 0, 0);
+                break;
+            case IR_ARG:
+                addCode(&l, OPC_ARG, getSlot(&l, cur->u.oneOp.op), 0, 0);
+                break;
+            case IR_CALL: {
+                char* name = getOperand(interCodeList, cur->u.assign.right)->u.name;
+                int func = funcOfName[getNameIndex(names, name)];
+                if (func < 0) {
+                    fprintf(stderr, "Cannot interpret: undefined function \"%s\".\n", name);
+                    ok = FALSE;
+                    break;
+                }
+                addCode(&l, OPC_CALL, getSlot(&l, cur->u.assign.left), func, 0);
+                break;
+            }
+            case IR_READ:
+                addCode(&l, OPC_READ, getSlot(&l, cur->u.oneOp.op), 0, 0);
+                break;
+            case IR_WRITE:
+                addCode(&l, OPC_WRITE, getSlot(&l, cur->u.oneOp.op), 0, 0);
+                break;
+            default:
+                assert(0);
+        }
+    }
+    if (l.curFunc >= 0)
+        addCode(&l, OPC_END, 0, 0, 0);
+
+    // labels resolve to code indices only once every LABEL has been seen
+    for (int i = 0; i < p->count && ok; i++) {
+        pInterpCode cur = &p->codes[i];
+        int* target = NULL;
+        if (cur->op == OPC_GOTO) target = &cur->a;
+        else if (cur->op >= OPC_IF_EQ && cur->op <= OPC_IF_GE) target = &cur->c;
+        else continue;
+        if (*target <= 0 || *target >= interCodeList->labelNum || labelTarget[*target] < 0) {
+            fprintf(stderr, "Cannot interpret: undefined label%d.\n", *target);
+            ok = FALSE;
+            break;
+        }
+        *target = labelTarget[*target];
+    }
+
+    free(l.tempOwner);
+    free(l.tempOff);
+    free(l.nameOwner);
+    free(l.nameOff);
+    free(l.constOwner);
+    free(l.constOff);
+    free(funcOfName);
+    free(labelTarget);
+    if (!ok) {
+        deleteInterpProgram(p);
+        return NULL;
+    }
+    return p;
+}
+
+void deleteInterpProgram(pInterpProgram p) {
+    assert(p != NULL);
+    for (int i = 0; i < p->funcNum; i++) {
+        free(p->funcs[i].frame);
+        free(p->funcs[i].params);
+    }
+    free(p->funcs);
+    free(p->codes);
+    free(p);
+}
+
+// run func
+typedef struct interpCall {
+    pInterpCode ret;
+    int* fp;
+    int dest;
+} InterpCall;
+
+static double getTime() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+// computed goto with gcc and clang, a plain switch elsewhere or with -DINTERP_SWITCH
+#if defined(__GNUC__) && !defined(INTERP_SWITCH)
+#define INTERP_COMPUTED_GOTO
+#endif
+
+#ifdef INTERP_COMPUTED_GOTO
+#define DISPATCH() do { count++; goto *dispatchTable[pc->op]; } while (0)
+#define CASE(op) L_##op
+#else
+#define DISPATCH() do { count++; goto dispatch; } while (0)
+#define CASE(op) case op
+#endif
+#define V(x) fp[pc->x]
+#define FAIL(msg) do { error = msg; goto done; } while (0)
+
+int runInterpProgram(pInterpProgram p, FILE* in, FILE* out, pInterpStat stat) {
+    assert(p != NULL && p->mainFunc >= 0);
+    int* mem = (int*)malloc(sizeof(int) * INTERP_MEMORY_SIZE);
+    InterpCall* calls = (InterpCall*)malloc(sizeof(InterpCall) * INTERP_CALL_DEPTH);
+    int* args = (int*)malloc(sizeof(int) * INTERP_ARG_DEPTH);
+    assert(mem != NULL && calls != NULL && args != NULL);
+    pOutBuffer o = newOutBuffer(out);
+    int callTop = 0, argTop = 0;
+    long long count = 0;
+    const char* error = NULL;
+    int retVal = 0;
+    double start = getTime();
+#ifdef INTERP_COMPUTED_GOTO
+    static void* dispatchTable[OPC_NUM] = {
+        [OPC_MOV] = &&L_OPC_MOV,        [OPC_ADD] = &&L_OPC_ADD,        [OPC_SUB] = &&L_OPC_SUB,
+        [OPC_MUL] = &&L_OPC_MUL,        [OPC_DIV] = &&L_OPC_DIV,        [OPC_ADDR] = &&L_OPC_ADDR,
+        [OPC_LOAD] = &&L_OPC_LOAD,      [OPC_STORE] = &&L_OPC_STORE,    [OPC_GOTO] = &&L_OPC_GOTO,
+        [OPC_IF_EQ] = &&L_OPC_IF_EQ,    [OPC_IF_NE] = &&L_OPC_IF_NE,    [OPC_IF_LT] = &&L_OPC_IF_LT,
+        [OPC_IF_GT] = &&L_OPC_IF_GT,    [OPC_IF_LE] = &&L_OPC_IF_LE,    [OPC_IF_GE] = &&L_OPC_IF_GE,
+        [OPC_RETURN] = &&L_OPC_RETURN,  [OPC_ARG] = &&L_OPC_ARG,        [OPC_CALL] = &&L_OPC_CALL,
+        [OPC_READ] = &&L_OPC_READ,      [OPC_WRITE] = &&L_OPC_WRITE,    [OPC_END] = &&L_OPC_END,
+    };
+#endif
+
+    pInterpFunc f = &p->funcs[p->mainFunc];
+    int* fp = mem;
+    int* sp = fp + f->frameSize;
+    if (f->frameSize > INTERP_MEMORY_SIZE) {
+        error = "stack overflow";
+        goto done;
+    }
+    memcpy(fp, f->frame, sizeof(int) * f->frameSize);
+    pInterpCode pc = &p->codes[f->entry];
+    DISPATCH();
+
+#ifndef INTERP_COMPUTED_GOTO
+dispatch:
+    switch (pc->op) {
+#endif
+    CASE(OPC_MOV):
+        V(a) = V(b);
+        pc++;
+        DISPATCH();
+    CASE(OPC_ADD):
+        V(a) = (int)((unsigned)V(b) + (unsigned)V(c));
+        pc++;
+        DISPATCH();
+    CASE(OPC_SUB):
+        V(a) = (int)((unsigned)V(b) - (unsigned)V(c));
+        pc++;
+        DISPATCH();
+    CASE(OPC_MUL):
+        V(a) = (int)((unsigned)V(b) * (unsigned)V(c));
+        pc++;
+        DISPATCH();
+    CASE(OPC_DIV):
+        if (V(c) == 0) FAIL("division by zero");
+        V(a) = V(c) == -1 ? (int)(0u - (unsigned)V(b)) : V(b) / V(c);
+        pc++;
+        DISPATCH();
+    CASE(OPC_ADDR):
+        V(a) = (int)((fp - mem + pc->b) * 4);
+        pc++;
+        DISPATCH();
+    CASE(OPC_LOAD): {
+        unsigned addr = V(b);
+        if (addr >= INTERP_MEMORY_SIZE * 4u || (addr & 3)) FAIL("bad address");
+        V(a) = mem[addr >> 2];
+        pc++;
+        DISPATCH();
+    }
+    CASE(OPC_STORE): {
+        unsigned addr = V(a);
+        if (addr >= INTERP_MEMORY_SIZE * 4u || (addr & 3)) FAIL("bad address");
+        mem[addr >> 2] = V(b);
+        pc++;
+        DISPATCH();
+    }
+    CASE(OPC_GOTO):
+        pc = &p->codes[pc->a];
+        DISPATCH();
+    CASE(OPC_IF_EQ):
+        pc = V(a) == V(b) ? &p->codes[pc->c] : pc + 1;
+        DISPATCH();
+    CASE(OPC_IF_NE):
+        pc = V(a) != V(b) ? &p->codes[pc->c] : pc + 1;
+        DISPATCH();
+    CASE(OPC_IF_LT):
+        pc = V(a) < V(b) ? &p->codes[pc->c] : pc + 1;
+        DISPATCH();
+    CASE(OPC_IF_GT):
+        pc = V(a) > V(b) ? &p->codes[pc->c] : pc + 1;
+        DISPATCH();
+    CASE(OPC_IF_LE):
+        pc = V(a) <= V(b) ? &p->codes[pc->c] : pc + 1;
+        DISPATCH();
+    CASE(OPC_IF_GE):
+        pc = V(a) >= V(b) ? &p->codes[pc->c] : pc + 1;
+        DISPATCH();
+    CASE(OPC_ARG):
+        if (argTop == INTERP_ARG_DEPTH) FAIL("too many arguments");
+        args[argTop++] = V(a);
+        pc++;
+        DISPATCH();
+    CASE(OPC_CALL): {
+        pInterpFunc g = &p->funcs[pc->b];
+        if (argTop < g->paramNum) FAIL("missing arguments");
+        if (callTop == INTERP_CALL_DEPTH || g->frameSize > mem + INTERP_MEMORY_SIZE - sp) FAIL("stack overflow");
+        calls[callTop++] = (InterpCall){pc + 1, fp, pc->a};
+        memcpy(sp, g->frame, sizeof(int) * g->frameSize);
+        // the last ARG before a CALL is the first PARAM
+        for (int i = 0; i < g->paramNum; i++)
+            sp[g->params[i]] = args[argTop - 1 - i];
+        argTop -= g->paramNum;
+        fp = sp;
+        sp += g->frameSize;
+        pc = &p->codes[g->entry];
+        DISPATCH();
+    }
+    CASE(OPC_RETURN):
+        retVal = V(a);
+        goto ret;
+    CASE(OPC_END):
+        retVal = 0;
+    ret:
+        if (callTop == 0) goto done;
+        callTop--;
+        sp = fp;
+        fp = calls[callTop].fp;
+        pc = calls[callTop].ret;
+        fp[calls[callTop].dest] = retVal;
+        DISPATCH();
+    CASE(OPC_READ):
+        flushOutBuffer(o);
+        if (fscanf(in, "%d", &V(a)) != 1) FAIL("no input for READ");
+        pc++;
+        DISPATCH();
+    CASE(OPC_WRITE):
+        putInt(o, V(a));
+        putChar(o, '\n');
+        pc++;
+        DISPATCH();
+#ifndef INTERP_COMPUTED_GOTO
+    default:
+        assert(0);
+    }
+#endif
+
+done:
+    if (stat != NULL) {
+        stat->codeCount = count;
+        stat->seconds = getTime() - start;
+        stat->retVal = retVal;
+    }
+    deleteOutBuffer(o);
+    free(mem);
+    free(calls);
+    free(args);
+    if (error != NULL) {
+        fprintf(stderr, "Runtime error: %s.\n", error);
+        return 1;
+    }
+    return 0;
+}
+
+int interpret(pInterCodeList interCodeList, FILE* in, FILE* out, pInterpStat stat) {
+    pInterpProgram p = newInterpProgram(interCodeList);
+    if (p == NULL)
+        return 1;
+    int ret = runInterpProgram(p, in, out, stat);
+    deleteInterpProgram(p);
+    return ret;
+}
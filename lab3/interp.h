@@ -0,0 +1,77 @@
+#ifndef INTERP_H
+#define INTERP_H
+#include "inter.h"
+
+#define INTERP_MEMORY_SIZE 0x400000     // words of frame memory
+#define INTERP_CALL_DEPTH 0x10000
+#define INTERP_ARG_DEPTH 0x10000
+
+typedef struct interpStat* pInterpStat;
+typedef struct interpFunc* pInterpFunc;
+typedef struct interpCode* pInterpCode;
+typedef struct interpProgram* pInterpProgram;
+
+// opcodes of the resolved program, IR_IF_GOTO is split by relop
+typedef enum {
+    OPC_MOV,
+    OPC_ADD,
+    OPC_SUB,
+    OPC_MUL,
+    OPC_DIV,
+    OPC_ADDR,
+    OPC_LOAD,
+    OPC_STORE,
+    OPC_GOTO,
+    OPC_IF_EQ,
+    OPC_IF_NE,
+    OPC_IF_LT,
+    OPC_IF_GT,
+    OPC_IF_LE,
+    OPC_IF_GE,
+    OPC_RETURN,
+    OPC_ARG,
+    OPC_CALL,
+    OPC_READ,
+    OPC_WRITE,
+    OPC_END,        // falls off the end of a function
+    OPC_NUM,
+} InterpOpcode;
+
+// a, b, c are frame word offsets, except jump targets (code index) and CALL's b (function index)
+typedef struct interpCode {
+    InterpOpcode op;
+    int a, b, c;
+} InterpCode;
+
+typedef struct interpFunc {
+    char* name;
+    int entry;          // index of the first code after the PARAMs
+    int frameSize;      // in words
+    int* frame;         // initial frame, constants are preloaded into their slots
+    int paramNum;
+    int* params;        // frame offsets of the PARAMs in order
+} InterpFunc;
+
+typedef struct interpProgram {
+    pInterpCode codes;
+    int count;
+    pInterpFunc funcs;
+    int funcNum;
+    int mainFunc;
+} InterpProgram;
+
+typedef struct interpStat {
+    long long codeCount;
+    double seconds;
+    int retVal;
+} InterpStat;
+
+// InterpProgram func
+pInterpProgram newInterpProgram(pInterCodeList interCodeList);
+void deleteInterpProgram(pInterpProgram p);
+
+// run func
+int runInterpProgram(pInterpProgram p, FILE* in, FILE* out, pInterpStat stat);
+int interpret(pInterCodeList interCodeList, FILE* in, FILE* out, pInterpStat stat);
+
+#endif
@@ -848,137 +848,137 @@ YY_RULE_SETUP
 case 3:
 YY_RULE_SETUP
 #line 50 "lexical.l"
-{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, "SEMI", yytext); return SEMI;}
+{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, N_SEMI, yytext); return SEMI;}
 	YY_BREAK
 case 4:
 YY_RULE_SETUP
 #line 51 "lexical.l"
-{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, "COMMA", yytext); return COMMA;}
+{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, N_COMMA, yytext); return COMMA;}
 	YY_BREAK
 case 5:
 YY_RULE_SETUP
 #line 52 "lexical.l"
-{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, "ASSIGNOP", yytext); return ASSIGNOP;}
+{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, N_ASSIGNOP, yytext); return ASSIGNOP;}
 	YY_BREAK
 case 6:
 YY_RULE_SETUP
 #line 53 "lexical.l"
-{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, "RELOP", yytext); return RELOP;}
+{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, N_RELOP, yytext); return RELOP;}
 	YY_BREAK
 case 7:
 YY_RULE_SETUP
 #line 54 "lexical.l"
-{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, "PLUS", yytext); return PLUS;}
+{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, N_PLUS, yytext); return PLUS;}
 	YY_BREAK
 case 8:
 YY_RULE_SETUP
 #line 55 "lexical.l"
-{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, "MINUS", yytext); return MINUS;}
+{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, N_MINUS, yytext); return MINUS;}
 	YY_BREAK
 case 9:
 YY_RULE_SETUP
 #line 56 "lexical.l"
-{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, "STAR", yytext); return STAR;}
+{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, N_STAR, yytext); return STAR;}
 	YY_BREAK
 case 10:
 YY_RULE_SETUP
 #line 57 "lexical.l"
-{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, "DIV", yytext); return DIV;}
+{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, N_DIV, yytext); return DIV;}
 	YY_BREAK
 case 11:
 YY_RULE_SETUP
 #line 58 "lexical.l"
-{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, "AND", yytext); return AND;}
+{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, N_AND, yytext); return AND;}
 	YY_BREAK
 case 12:
 YY_RULE_SETUP
 #line 59 "lexical.l"
-{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, "OR", yytext); return OR;}
+{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, N_OR, yytext); return OR;}
 	YY_BREAK
 case 13:
 YY_RULE_SETUP
 #line 60 "lexical.l"
-{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, "DOT", yytext); return DOT;}
+{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, N_DOT, yytext); return DOT;}
 	YY_BREAK
 case 14:
 YY_RULE_SETUP
 #line 61 "lexical.l"
-{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, "NOT", yytext); return NOT;}
+{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, N_NOT, yytext); return NOT;}
 	YY_BREAK
 case 15:
 YY_RULE_SETUP
 #line 62 "lexical.l"
-{yylval.node = newTokenNode(yylineno, TYPE_TOKEN, "TYPE", yytext); return TYPE;}
+{yylval.node = newTokenNode(yylineno, TYPE_TOKEN, N_TYPE, yytext); return TYPE;}
 	YY_BREAK
 case 16:
 YY_RULE_SETUP
 #line 63 "lexical.l"
-{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, "LP", yytext); return LP;}
+{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, N_LP, yytext); return LP;}
 	YY_BREAK
 case 17:
 YY_RULE_SETUP
 #line 64 "lexical.l"
-{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, "RP", yytext); return RP;}
+{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, N_RP, yytext); return RP;}
 	YY_BREAK
 case 18:
 YY_RULE_SETUP
 #line 65 "lexical.l"
-{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, "LB", yytext); return LB;}
+{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, N_LB, yytext); return LB;}
 	YY_BREAK
 case 19:
 YY_RULE_SETUP
 #line 66 "lexical.l"
-{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, "RB", yytext); return RB;}
+{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, N_RB, yytext); return RB;}
 	YY_BREAK
 case 20:
 YY_RULE_SETUP
 #line 67 "lexical.l"
-{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, "LC", yytext); return LC;}
+{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, N_LC, yytext); return LC;}
 	YY_BREAK
 case 21:
 YY_RULE_SETUP
 #line 68 "lexical.l"
-{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, "RC", yytext); return RC;}
+{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, N_RC, yytext); return RC;}
 	YY_BREAK
 case 22:
 YY_RULE_SETUP
 #line 69 "lexical.l"
-{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, "STRUCT", yytext); return STRUCT; }
+{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, N_STRUCT, yytext); return STRUCT; }
 	YY_BREAK
 case 23:
 YY_RULE_SETUP
 #line 70 "lexical.l"
-{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, "RETURN", yytext); return RETURN;}
+{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, N_RETURN, yytext); return RETURN;}
 	YY_BREAK
 case 24:
 YY_RULE_SETUP
 #line 71 "lexical.l"
-{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, "IF", yytext); return IF;}
+{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, N_IF, yytext); return IF;}
 	YY_BREAK
 case 25:
 YY_RULE_SETUP
 #line 72 "lexical.l"
-{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, "ELSE", yytext); return ELSE;}
+{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, N_ELSE, yytext); return ELSE;}
 	YY_BREAK
 case 26:
 YY_RULE_SETUP
 #line 73 "lexical.l"
-{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, "WHILE", yytext); return WHILE;}
+{yylval.node = newTokenNode(yylineno, OTHER_TOKEN, N_WHILE, yytext); return WHILE;}
 	YY_BREAK
 case 27:
 YY_RULE_SETUP
 #line 75 "lexical.l"
-{yylval.node = newTokenNode(yylineno, INT_TOKEN, "INT", yytext); return INT;}
+{yylval.node = newTokenNode(yylineno, INT_TOKEN, N_INT, yytext); return INT;}
 	YY_BREAK
 case 28:
 YY_RULE_SETUP
 #line 76 "lexical.l"
-{yylval.node = newTokenNode(yylineno, FLOAT_TOKEN, "FLOAT", yytext); return FLOAT;}
+{yylval.node = newTokenNode(yylineno, FLOAT_TOKEN, N_FLOAT, yytext); return FLOAT;}
 	YY_BREAK
 case 29:
 YY_RULE_SETUP
 #line 77 "lexical.l"
-{yylval.node = newTokenNode(yylineno, ID_TOKEN, "ID", yytext); return ID;}
+{yylval.node = newTokenNode(yylineno, ID_TOKEN, N_ID, yytext); return ID;}
 	YY_BREAK
 case 30:
 YY_RULE_SETUP
@@ -1,4 +1,8 @@
-#include "inter.h"
+#include "cfg.h"
+#include "interp.h"
+#include "mips.h"
+#include "x86.h"
+#include "opt.h"
 #include "syntax.tab.h"
 
 extern int yyparse();
@@ -8,37 +12,222 @@ extern pNode root;
 int lexError = 0;
 int synError = 0;
 
+// what is done with the IR once it is generated or read
+static enum {
+    OUT_TEXT,
+    OUT_BINARY,
+    OUT_DOT,
+    OUT_RUN,
+    OUT_MIPS,
+    OUT_X86,
+} outMode = OUT_TEXT;
+// how the front end walks the tree
+static enum {
+    FRONT_FUSED,
+    FRONT_TWO_PASS,
+    FRONT_CHECK,
+    FRONT_STREAM,
+} frontMode = FRONT_FUSED;
+static boolean optimized = FALSE;
+static boolean showStat = FALSE;
+
+static FILE* streamOut;
+static int streamTemps, streamLabels;     // numbers taken by the functions already written
+
+// -stream: each ExtDef is checked, translated and written as soon as it is parsed, then its scopes,
+// nodes and IR are dropped, so memory follows the largest function instead of the file
+static void streamExtDef(pNode extDef) {
+    if (lexError || synError || interError)
+        return;
+    int depth = table->stack->curStackDepth;
+    ExtDef(extDef);
+    translateExtDef(extDef);
+    clearStackAbove(table, depth);
+    if (interError)
+        return;
+    // each function is numbered from 1 so the passes size their tables by it alone
+    if (optimized && interCodeList->count > 0) {
+        OptStat stat;
+        optimize(interCodeList, &stat);
+    }
+    shiftInterCodeNumbers(interCodeList, streamTemps, streamLabels);
+    printInterCode(streamOut, interCodeList);
+    streamTemps += interCodeList->tempVarNum - 1;
+    streamLabels += interCodeList->labelNum - 1;
+    clearInterCodeList(interCodeList);
+}
+
+static int emitOrRun(FILE* fw) {
+    if (optimized) {
+        OptStat stat;
+        optimize(interCodeList, &stat);
+        if (showStat)
+            printOptStat(stderr, &stat);
+    }
+    switch (outMode) {
+        case OUT_TEXT:
+            printInterCode(fw, interCodeList);
+            return 0;
+        case OUT_BINARY:
+            writeInterCode(fw, interCodeList);
+            return 0;
+        case OUT_DOT:
+            printInterCodeDot(fw, interCodeList);
+            return 0;
+        case OUT_RUN: {
+            InterpStat stat;
+            int ret = interpret(interCodeList, stdin, fw, &stat);
+            if (showStat && ret == 0)
+                fprintf(stderr, "%lld codes in %.3f s (%.1f M codes/s), main returned %d\n",
+                        stat.codeCount, stat.seconds, stat.codeCount / stat.seconds / 1e6, stat.retVal);
+            return ret;
+        }
+        case OUT_MIPS: {
+            MipsStat stat;
+            printMips(fw, interCodeList, &stat);
+            if (showStat)
+                fprintf(stderr, "%d functions, %d variables, %d spilled, %d interference edges\n",
+                        stat.funcNum, stat.varNum, stat.spillNum, stat.edgeNum);
+            return 0;
+        }
+        case OUT_X86: {
+            X86Stat stat;
+            printX86(fw, interCodeList, &stat);
+            if (showStat)
+                fprintf(stderr, "%d functions, %d variables, %d spilled\n", stat.funcNum, stat.varNum, stat.spillNum);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// usage: parser [-b | -dot | -i | -s | -x] [-r] [-twopass | -check | -stream] [-O] [-stat] input [output]
+//   -b     write binary IR instead of text
+//   -dot   write the control flow graph of every function in graphviz format
+//   -i     run the IR, READ takes stdin and WRITE goes to output
+//   -s     write MIPS32 assembly for SPIM instead of IR
+//   -x     write x86-64 GNU assembly instead of IR, link it with cc
+//   -r     input is binary IR written by -b, skip the front end
+//   -twopass  check the whole program before translating any of it, instead of one ExtDef at a time
+//   -check    only report semantic errors, no IR
+//   -stream   write the text IR of each ExtDef as soon as it is parsed and free it, memory follows the
+//             largest function plus the global symbols; structs defined in a function end with it, and
+//             what is written stays when a later ExtDef has an error
+//   -O     optimize the IR before writing or running it
+//   -stat  report what -O did, with -i executed codes and time, with -s or -x register allocation, on stderr
+// exit status: 1 for bad usage, an input or output that can't be opened, invalid binary IR or a runtime
+// error under -i; with -check or -twopass also for any lexical, syntax or semantic error, the default
+// front end and -stream only report those on stdout and exit with 0 like the lab expects
+static const char usage[] =
+    "usage: parser [-b | -dot | -i | -s | -x] [-r] [-twopass | -check | -stream] [-O] [-stat] input [output]\n";
 int main(int argc, char** argv) 
 {
-    if (argc <= 1) 
+    boolean binaryIn = FALSE;
+    char* files[2] = {NULL, NULL};
+    int fileNum = 0;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-b"))
+            outMode = OUT_BINARY;
+        else if (!strcmp(argv[i], "-dot"))
+            outMode = OUT_DOT;
+        else if (!strcmp(argv[i], "-i"))
+            outMode = OUT_RUN;
+        else if (!strcmp(argv[i], "-s"))
+            outMode = OUT_MIPS;
+        else if (!strcmp(argv[i], "-x"))
+            outMode = OUT_X86;
+        else if (!strcmp(argv[i], "-r"))
+            binaryIn = TRUE;
+        else if (!strcmp(argv[i], "-twopass"))
+            frontMode = FRONT_TWO_PASS;
+        else if (!strcmp(argv[i], "-check"))
+            frontMode = FRONT_CHECK;
+        else if (!strcmp(argv[i], "-stream"))
+            frontMode = FRONT_STREAM;
+        else if (!strcmp(argv[i], "-O"))
+            optimized = TRUE;
+        else if (!strcmp(argv[i], "-stat"))
+            showStat = TRUE;
+        else if (fileNum < 2)
+            files[fileNum++] = argv[i];
+        else {
+            fprintf(stderr, "unexpected argument %s\n%s", argv[i], usage);
+            return 1;
+        }
+    }
+    if (fileNum == 0) {
+        fprintf(stderr, "no input file\n%s", usage);
         return 1;
+    }
+    // nothing but text can be written a function at a time
+    if (frontMode == FRONT_STREAM && (outMode != OUT_TEXT || binaryIn || showStat)) {
+        fprintf(stderr, "-stream only writes text IR, it takes none of -b, -dot, -i, -s, -x, -r and -stat\n");
+        return 1;
+    }
     
-    FILE* fr = fopen(argv[1], "r");
+    FILE* fr = fopen(files[0], binaryIn ? "rb" : "r");
     if (!fr) {
-        perror(argv[1]);
+        perror(files[0]);
         return 1;
     }
 
-    FILE* fw = fopen(argv[2], "wt+");
-    if (!fw) {
-        perror(argv[2]);
-        return 1;
+    // no output file or "-" writes the IR to stdout
+    FILE* fw = stdout;
+    if (files[1] != NULL && strcmp(files[1], "-")) {
+        fw = fopen(files[1], outMode == OUT_BINARY ? "wb" : "wt+");
+        if (!fw) {
+            perror(files[1]);
+            return 1;
+        }
+    }
+
+    if (binaryIn) {
+        interCodeList = readInterCode(fr);
+        if (interCodeList == NULL) {
+            fprintf(stderr, "%s: not a valid binary IR file\n", files[0]);
+            return 1;
+        }
+        int ret = emitOrRun(fw);
+        deleteInterCodeList(interCodeList);
+        return ret;
     }
 
+    int ret = 0;
+    nodeArena = newArena(ARENA_BLOCK_SIZE);
     yyrestart(fr);
-    yyparse();
-    if (!lexError && !synError) {
+    if (frontMode == FRONT_STREAM) {
         table = initTable();
-        traverseTree(root);
-
-        interCodeList = newInterCodeList();  
-        genInterCodes(root);
-        if (!interError)
-            printInterCode(fw, interCodeList);
+        interCodeList = newInterCodeList();
+        streamOut = fw;
+        extDefHandler = streamExtDef;
+        yyparse();
+        deleteInterCodeList(interCodeList);
+        deleteTable(table);
+    }
+    // a syntax error no rule recovers from aborts the parse without setting synError
+    else if (yyparse() != 0)
+        synError = 1;
+    if (!lexError && !synError && frontMode != FRONT_STREAM) {
+        table = initTable();
+        if (frontMode == FRONT_CHECK)
+            traverseTree(root);
+        else {
+            interCodeList = newInterCodeList();  
+            if (frontMode == FRONT_TWO_PASS) {
+                traverseTree(root);
+                genInterCodes(root);
+            }
+            else
+                checkAndGenInterCodes(root);
+            if (!interError)
+                ret = emitOrRun(fw);
+        }
 
         deleteTable(table);
     }
     
-    delNode(root);
-    return 0;
+    if ((frontMode == FRONT_CHECK || frontMode == FRONT_TWO_PASS) && (lexError || synError || semError))
+        ret = 1;
+    deleteNodes();
+    return ret;
 }
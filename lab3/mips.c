@@ -0,0 +1,664 @@
+#include "mips.h"
+
+static const char* colorNames[MIPS_COLOR_NUM] = {
+    "$t0", "$t1", "$t2", "$t3", "$t4", "$t5", "$t6", "$t7",
+    "$s0", "$s1", "$s2", "$s3", "$s4", "$s5", "$s6", "$s7",
+};
+static const char* argNames[MIPS_ARG_REG_NUM] = {"$a0", "$a1", "$a2", "$a3"};
+
+// read and write are the usual SPIM syscall wrappers, they only touch $v0, $a0 and $ra
+static const char* prelude =
+    ".data\n"
+    "_prompt: .asciiz \"Enter an integer:\"\n"
+    "_ret: .asciiz \"\\n\"\n"
+    ".globl main\n"
+    ".text\n"
+    "read:\n"
+    "  li $v0, 4\n"
+    "  la $a0, _prompt\n"
+    "  syscall\n"
+    "  li $v0, 5\n"
+    "  syscall\n"
+    "  jr $ra\n"
+    "\n"
+    "write:\n"
+    "  li $v0, 1\n"
+    "  syscall\n"
+    "  li $v0, 4\n"
+    "  la $a0, _ret\n"
+    "  syscall\n"
+    "  move $v0, $0\n"
+    "  jr $ra\n";
+
+typedef struct edgeSet {
+    unsigned long long* slots;  // a << 32 | b with a < b, EDGE_EMPTY when free
+    int size;
+    int count;
+    int* pairs;         // the edges in insertion order
+} EdgeSet;
+
+#define EDGE_EMPTY (~0ULL)
+
+// register allocation of one function, nodes are the variables the function mentions
+typedef struct mipsFunc {
+    pInterCodeList list;
+    pCfg cfg;
+    pLiveness live;
+    int* nodeOf;        // per key, -1 if the key is no node, reset after the function
+    int* keys;          // key of a node
+    int nodeNum;
+    int* color;         // -1 for nodes living in the frame
+    int* offset;        // $fp offset of nodes living in the frame
+    int* size;          // bytes of DEC storage, 0 for scalars
+    boolean* inFrame;   // DEC storage and variables whose address is taken never get a register
+    boolean* crossCall; // live across a CALL, so only $s registers will do
+    long long* cost;    // defs and uses weighted by 10 per loop level
+    int* partner;       // the other side of a copy, its color is tried first
+    int* adjStart;
+    int* adj;
+    EdgeSet edges;
+    int savedMask;      // $s registers to save
+    int frameSize;
+} MipsFunc;
+
+static void addEdge(EdgeSet* e, int a, int b) {
+    if (a > b) {
+        int t = a;
+        a = b;
+        b = t;
+    }
+    if (e->count * 2 >= e->size) {
+        unsigned long long* old = e->slots;
+        int oldSize = e->size;
+        e->size = e->size == 0 ? 0x400 : e->size * 2;
+        e->slots = (unsigned long long*)malloc(sizeof(unsigned long long) * e->size);
+        e->pairs = (int*)realloc(e->pairs, sizeof(int) * e->size);
+        assert(e->slots != NULL && e->pairs != NULL);
+        for (int i = 0; i < e->size; i++)
+            e->slots[i] = EDGE_EMPTY;
+        for (int i = 0; i < oldSize; i++) {
+            if (old[i] == EDGE_EMPTY) continue;
+            int j = (int)((old[i] * 0x9e3779b97f4a7c15ULL) >> 32) & (e->size - 1);
+            while (e->slots[j] != EDGE_EMPTY)
+                j = (j + 1) & (e->size - 1);
+            e->slots[j] = old[i];
+        }
+        free(old);
+    }
+    unsigned long long k = (unsigned long long)a << 32 | (unsigned)b;
+    int j = (int)((k * 0x9e3779b97f4a7c15ULL) >> 32) & (e->size - 1);
+    while (e->slots[j] != EDGE_EMPTY) {
+        if (e->slots[j] == k) return;
+        j = (j + 1) & (e->size - 1);
+    }
+    e->slots[j] = k;
+    e->pairs[e->count * 2] = a;
+    e->pairs[e->count * 2 + 1] = b;
+    e->count++;
+}
+
+static void addNode(MipsFunc* f, int index) {
+    int key = getVarKey(f->list, index);
+    if (key < 0 || f->nodeOf[key] >= 0) return;
+    f->nodeOf[key] = f->nodeNum;
+    f->keys[f->nodeNum++] = key;
+}
+
+static int getNode(MipsFunc* f, int index) {
+    int key = getVarKey(f->list, index);
+    return key < 0 ? -1 : f->nodeOf[key];
+}
+
+// Chaitin-Briggs over the interference graph, optimistic: a node without a low degree
+// neighbour count is pushed anyway, cheapest per edge first, and spilled only if select finds
+// no color. Spilled operands go through $t8 and $t9, so no code is rewritten afterwards.
+static void colorNodes(MipsFunc* f) {
+    int n = f->nodeNum;
+    int* degree = (int*)calloc(n + 1, sizeof(int));
+    int* stack = (int*)malloc(sizeof(int) * (n + 1));
+    int* low = (int*)malloc(sizeof(int) * (n + 1));
+    int* rest = (int*)malloc(sizeof(int) * (n + 1));
+    boolean* removed = (boolean*)calloc(n + 1, sizeof(boolean));
+    assert(degree != NULL && stack != NULL && low != NULL && rest != NULL && removed != NULL);
+
+    int top = 0, lowNum = 0, restNum = 0;
+    for (int i = 0; i < n; i++) {
+        f->color[i] = -1;
+        if (f->inFrame[i]) {
+            removed[i] = TRUE;
+            continue;
+        }
+        degree[i] = f->adjStart[i + 1] - f->adjStart[i];
+        if (degree[i] < MIPS_COLOR_NUM)
+            low[lowNum++] = i;
+        else
+            rest[restNum++] = i;
+    }
+    while (top < n) {
+        int v;
+        if (lowNum > 0)
+            v = low[--lowNum];
+        else {
+            // drop rest entries that went low or were pushed, then take the cheapest
+            int best = -1, k = 0;
+            for (int j = 0; j < restNum; j++) {
+                int u = rest[j];
+                if (removed[u] || degree[u] < MIPS_COLOR_NUM) continue;
+                rest[k++] = u;
+                if (best < 0 || f->cost[u] * (degree[best] + 1) < f->cost[best] * (degree[u] + 1))
+                    best = u;
+            }
+            restNum = k;
+            if (best < 0) break;
+            v = best;
+        }
+        if (removed[v]) continue;
+        removed[v] = TRUE;
+        stack[top++] = v;
+        for (int j = f->adjStart[v]; j < f->adjStart[v + 1]; j++) {
+            int u = f->adj[j];
+            if (!removed[u] && degree[u]-- == MIPS_COLOR_NUM)
+                low[lowNum++] = u;
+        }
+    }
+
+    while (top > 0) {
+        int v = stack[--top];
+        unsigned used = 0;
+        for (int j = f->adjStart[v]; j < f->adjStart[v + 1]; j++)
+            if (f->color[f->adj[j]] >= 0) used |= 1u << f->color[f->adj[j]];
+        int from = f->crossCall[v] ? MIPS_SAVED_COLOR : 0;
+        int p = f->partner[v] >= 0 ? f->color[f->partner[v]] : -1;
+        if (p >= from && !(used >> p & 1))
+            f->color[v] = p;
+        else
+            for (int c = from; c < MIPS_COLOR_NUM; c++)
+                if (!(used >> c & 1)) {
+                    f->color[v] = c;
+                    break;
+                }
+        if (f->color[v] >= MIPS_SAVED_COLOR) f->savedMask |= 1 << (f->color[v] - MIPS_SAVED_COLOR);
+    }
+
+    free(degree);
+    free(stack);
+    free(low);
+    free(rest);
+    free(removed);
+}
+
+static void allocateRegisters(MipsFunc* f, pMipsStat stat) {
+    pInterCodeList interCodeList = f->list;
+    pCfg p = f->cfg;
+    pInterCode codes = interCodeList->codes;
+    f->nodeNum = 0;
+    for (int i = p->first; i < p->last; i++) {
+        pInterCode cur = &codes[i];
+        addNode(f, getCodeDef(cur));
+        int* uses[3];
+        int useNum = getCodeUses(cur, uses);
+        for (int j = 0; j < useNum; j++)
+            addNode(f, *uses[j]);
+        if (cur->kind == IR_DEC) addNode(f, cur->u.dec.op);
+        if (cur->kind == IR_GET_ADDR) addNode(f, cur->u.assign.right);
+    }
+
+    int n = f->nodeNum;
+    f->color = (int*)malloc(sizeof(int) * (n + 1));
+    f->offset = (int*)calloc(n + 1, sizeof(int));
+    f->size = (int*)calloc(n + 1, sizeof(int));
+    f->inFrame = (boolean*)calloc(n + 1, sizeof(boolean));
+    f->crossCall = (boolean*)calloc(n + 1, sizeof(boolean));
+    f->cost = (long long*)calloc(n + 1, sizeof(long long));
+    f->partner = (int*)malloc(sizeof(int) * (n + 1));
+    f->adjStart = (int*)calloc(n + 2, sizeof(int));
+    assert(f->color != NULL && f->offset != NULL && f->size != NULL && f->inFrame != NULL &&
+           f->crossCall != NULL && f->cost != NULL && f->partner != NULL && f->adjStart != NULL);
+    for (int i = 0; i < n; i++)
+        f->partner[i] = -1;
+    for (int i = p->first; i < p->last; i++) {
+        if (codes[i].kind == IR_DEC) {
+            int v = getNode(f, codes[i].u.dec.op);
+            f->inFrame[v] = TRUE;
+            f->size[v] = codes[i].u.dec.size;
+        }
+        if (codes[i].kind == IR_GET_ADDR) f->inFrame[getNode(f, codes[i].u.assign.right)] = TRUE;
+    }
+
+    // interference, walking each block backwards from its live out set
+    int* dense = (int*)malloc(sizeof(int) * (n + 1));
+    int* pos = (int*)malloc(sizeof(int) * (n + 1));
+    assert(dense != NULL && pos != NULL);
+    for (int i = 0; i < n; i++)
+        pos[i] = -1;
+    for (int b = 0; b < p->blockNum; b++) {
+        int liveNum = 0;
+        long long weight = 1;
+        for (int d = 0; d < p->blocks[b].loopDepth && d < 4; d++)
+            weight *= 10;
+        for (int k = 0; k < f->live->globalNum; k++) {
+            int key = f->live->globals[k];
+            int v = f->nodeOf[key];
+            if (v >= 0 && !f->inFrame[v] && isLiveOut(f->live, b, key)) {
+                pos[v] = liveNum;
+                dense[liveNum++] = v;
+            }
+        }
+        for (int i = p->blocks[b].last - 1; i >= p->blocks[b].first; i--) {
+            pInterCode cur = &codes[i];
+            int d = getNode(f, getCodeDef(cur));
+            if (d >= 0 && !f->inFrame[d]) {
+                int src = cur->kind == IR_ASSIGN ? getNode(f, cur->u.assign.right) : -1;
+                if (src >= 0 && !f->inFrame[src]) {
+                    f->partner[d] = src;
+                    f->partner[src] = d;
+                }
+                for (int j = 0; j < liveNum; j++)
+                    if (dense[j] != d && dense[j] != src) addEdge(&f->edges, d, dense[j]);
+                if (pos[d] >= 0) {
+                    int last = dense[--liveNum];
+                    dense[pos[d]] = last;
+                    pos[last] = pos[d];
+                    pos[d] = -1;
+                }
+                f->cost[d] += weight;
+            }
+            if (cur->kind == IR_CALL)
+                for (int j = 0; j < liveNum; j++)
+                    f->crossCall[dense[j]] = TRUE;
+            int* uses;
+            int useNum = getLiveUses(f->live, i, &uses);
+            for (int j = 0; j < useNum; j++) {
+                int v = f->nodeOf[uses[j]];
+                if (f->inFrame[v]) continue;
+                f->cost[v] += weight;
+                if (pos[v] < 0) {
+                    pos[v] = liveNum;
+                    dense[liveNum++] = v;
+                }
+            }
+        }
+        for (int j = 0; j < liveNum; j++)
+            pos[dense[j]] = -1;
+    }
+    free(dense);
+    free(pos);
+
+    int edgeNum = f->edges.count;
+    f->adj = (int*)malloc(sizeof(int) * (edgeNum * 2 + 1));
+    assert(f->adj != NULL);
+    for (int j = 0; j < edgeNum * 2; j++)
+        f->adjStart[f->edges.pairs[j] + 1]++;
+    for (int i = 0; i < n; i++)
+        f->adjStart[i + 1] += f->adjStart[i];
+    int* fill = (int*)malloc(sizeof(int) * (n + 1));
+    assert(fill != NULL);
+    memcpy(fill, f->adjStart, sizeof(int) * (n + 1));
+    for (int j = 0; j < edgeNum; j++) {
+        int a = f->edges.pairs[j * 2], b = f->edges.pairs[j * 2 + 1];
+        f->adj[fill[a]++] = b;
+        f->adj[fill[b]++] = a;
+    }
+    free(fill);
+
+    f->savedMask = 0;
+    colorNodes(f);
+
+    // $ra and the old $fp, the saved $s registers, scalar slots, then the DEC storage
+    int top = 8;
+    for (int c = 0; c < MIPS_COLOR_NUM - MIPS_SAVED_COLOR; c++)
+        if (f->savedMask >> c & 1) top += 4;
+    for (int v = 0; v < n; v++)
+        if (f->color[v] < 0 && f->size[v] == 0) {
+            top += 4;
+            f->offset[v] = -top;
+        }
+    for (int v = 0; v < n; v++)
+        if (f->size[v] > 0) {
+            top += (f->size[v] + 3) & ~3;
+            f->offset[v] = -top;
+        }
+    f->frameSize = top;
+
+    stat->funcNum++;
+    stat->edgeNum += edgeNum;
+    for (int v = 0; v < n; v++) {
+        if (f->inFrame[v]) continue;
+        stat->varNum++;
+        if (f->color[v] < 0) stat->spillNum++;
+    }
+}
+
+static void freeAllocation(MipsFunc* f) {
+    for (int v = 0; v < f->nodeNum; v++)
+        f->nodeOf[f->keys[v]] = -1;
+    free(f->color);
+    free(f->offset);
+    free(f->size);
+    free(f->inFrame);
+    free(f->crossCall);
+    free(f->cost);
+    free(f->partner);
+    free(f->adjStart);
+    free(f->adj);
+    free(f->edges.slots);
+    free(f->edges.pairs);
+    f->edges = (EdgeSet){NULL, 0, 0, NULL};
+}
+
+// emit func
+// one line of assembly, fmt knows %s, %d and %l for a label operand
+static void emitAsm(pOutBuffer out, const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    putString(out, "  ");
+    for (; *fmt; fmt++) {
+        if (*fmt != '%') {
+            putChar(out, *fmt);
+            continue;
+        }
+        fmt++;
+        if (*fmt == 's')
+            putString(out, va_arg(args, const char*));
+        else if (*fmt == 'l')
+            printOp(out, va_arg(args, pOperand));
+        else {
+            assert(*fmt == 'd');
+            putInt(out, va_arg(args, int));
+        }
+    }
+    putChar(out, '\n');
+    va_end(args);
+}
+
+static boolean isImmediate(int value) {
+    return value >= -0x8000 && value < 0x8000;
+}
+
+// lw or sw of reg at $fp + offset, offsets past 16 bits go through $t9
+static void emitFrameAccess(pOutBuffer out, const char* op, const char* reg, int offset) {
+    if (isImmediate(offset))
+        emitAsm(out, "%s %s, %d($fp)", op, reg, offset);
+    else {
+        emitAsm(out, "li $t9, %d", offset);
+        emitAsm(out, "add $t9, $t9, $fp");
+        emitAsm(out, "%s %s, 0($t9)", op, reg);
+    }
+}
+
+static void emitFuncLabel(pOutBuffer out, char* name) {
+    // every function but main gets a prefix, so none can clash with read, write or an opcode
+    if (strcmp(name, "main")) putString(out, "f_");
+    putString(out, name);
+}
+
+// the register holding an operand, loaded into scratch if it is a constant or lives in the frame
+static const char* useOperand(pOutBuffer out, MipsFunc* f, int index, const char* scratch) {
+    pOperand op = getOperand(f->list, index);
+    if (op->kind == OP_CONSTANT) {
+        if (op->u.value == 0) return "$zero";
+        emitAsm(out, "li %s, %d", scratch, op->u.value);
+        return scratch;
+    }
+    int v = getNode(f, index);
+    assert(v >= 0 && f->size[v] == 0);
+    if (f->color[v] >= 0) return colorNames[f->color[v]];
+    emitFrameAccess(out, "lw", scratch, f->offset[v]);
+    return scratch;
+}
+
+static void loadOperand(pOutBuffer out, MipsFunc* f, int index, const char* reg) {
+    const char* r = useOperand(out, f, index, reg);
+    if (r != reg) emitAsm(out, "move %s, %s", reg, r);
+}
+
+// the register to compute a def into, $t8 for a def that lives in the frame
+static const char* defOperand(MipsFunc* f, int index) {
+    int v = getNode(f, index);
+    assert(v >= 0);
+    return f->color[v] >= 0 ? colorNames[f->color[v]] : "$t8";
+}
+
+static void storeDef(pOutBuffer out, MipsFunc* f, int index) {
+    int v = getNode(f, index);
+    if (f->color[v] < 0) emitFrameAccess(out, "sw", "$t8", f->offset[v]);
+}
+
+static void emitAddress(pOutBuffer out, const char* reg, int offset) {
+    if (isImmediate(offset))
+        emitAsm(out, "addi %s, $fp, %d", reg, offset);
+    else {
+        emitAsm(out, "li %s, %d", reg, offset);
+        emitAsm(out, "add %s, %s, $fp", reg, reg);
+    }
+}
+
+static void emitPrologue(pOutBuffer out, MipsFunc* f) {
+    emitAsm(out, "sw $ra, -4($sp)");
+    emitAsm(out, "sw $fp, -8($sp)");
+    emitAsm(out, "move $fp, $sp");
+    if (isImmediate(-f->frameSize))
+        emitAsm(out, "addi $sp, $sp, %d", -f->frameSize);
+    else {
+        emitAsm(out, "li $t9, %d", f->frameSize);
+        emitAsm(out, "sub $sp, $sp, $t9");
+    }
+    for (int c = 0, offset = -12; c < MIPS_COLOR_NUM - MIPS_SAVED_COLOR; c++)
+        if (f->savedMask >> c & 1) {
+            emitAsm(out, "sw %s, %d($fp)", colorNames[MIPS_SAVED_COLOR + c], offset);
+            offset -= 4;
+        }
+}
+
+static void emitEpilogue(pOutBuffer out, MipsFunc* f) {
+    for (int c = 0, offset = -12; c < MIPS_COLOR_NUM - MIPS_SAVED_COLOR; c++)
+        if (f->savedMask >> c & 1) {
+            emitAsm(out, "lw %s, %d($fp)", colorNames[MIPS_SAVED_COLOR + c], offset);
+            offset -= 4;
+        }
+    emitAsm(out, "move $sp, $fp");
+    emitAsm(out, "lw $ra, -4($fp)");
+    emitAsm(out, "lw $fp, -8($fp)");
+    emitAsm(out, "jr $ra");
+}
+
+static void emitCall(pOutBuffer out, MipsFunc* f, int i) {
+    pInterCode codes = f->list->codes;
+    // the ARGs since the previous CALL, the last one is the first parameter
+    int first = i;
+    while (first > f->cfg->first && codes[first - 1].kind != IR_CALL && codes[first - 1].kind != IR_LABEL &&
+           codes[first - 1].kind != IR_FUNCTION)
+        first--;
+    int argNum = 0;
+    for (int j = first; j < i; j++)
+        if (codes[j].kind == IR_ARG) argNum++;
+    int stackNum = argNum > MIPS_ARG_REG_NUM ? argNum - MIPS_ARG_REG_NUM : 0;
+    if (stackNum > 0) emitAsm(out, "addi $sp, $sp, %d", -4 * stackNum);
+    for (int j = first, k = argNum; j < i; j++) {
+        if (codes[j].kind != IR_ARG) continue;
+        // k is the parameter number of this ARG, counting from 1
+        if (k <= MIPS_ARG_REG_NUM)
+            loadOperand(out, f, codes[j].u.oneOp.op, argNames[k - 1]);
+        else {
+            const char* r = useOperand(out, f, codes[j].u.oneOp.op, "$t9");
+            emitAsm(out, "sw %s, %d($sp)", r, 4 * (k - MIPS_ARG_REG_NUM - 1));
+        }
+        k--;
+    }
+    putString(out, "  jal ");
+    emitFuncLabel(out, getOperand(f->list, codes[i].u.assign.right)->u.name);
+    putChar(out, '\n');
+    if (stackNum > 0) emitAsm(out, "addi $sp, $sp, %d", 4 * stackNum);
+    emitAsm(out, "move %s, $v0", defOperand(f, codes[i].u.assign.left));
+    storeDef(out, f, codes[i].u.assign.left);
+}
+
+static void emitFunction(pOutBuffer out, MipsFunc* f) {
+    pInterCodeList interCodeList = f->list;
+    pInterCode codes = interCodeList->codes;
+    static const char* relops[][2] = {{"==", "beq"}, {"!=", "bne"}, {"<", "blt"}, {">", "bgt"}, {"<=", "ble"}, {">=", "bge"}};
+    int paramNum = 0;
+
+    for (int i = f->cfg->first; i < f->cfg->last; i++) {
+        pInterCode cur = &codes[i];
+        switch (cur->kind) {
+            case IR_FUNCTION:
+                putChar(out, '\n');
+                emitFuncLabel(out, getOperand(interCodeList, cur->u.oneOp.op)->u.name);
+                putString(out, ":\n");
+                emitPrologue(out, f);
+                break;
+            case IR_PARAM: {
+                int v = getNode(f, cur->u.oneOp.op);
+                paramNum++;
+                const char* r = defOperand(f, cur->u.oneOp.op);
+                if (paramNum <= MIPS_ARG_REG_NUM)
+                    emitAsm(out, "move %s, %s", r, argNames[paramNum - 1]);
+                else
+                    emitAsm(out, "lw %s, %d($fp)", r, 4 * (paramNum - MIPS_ARG_REG_NUM - 1));
+                if (f->color[v] < 0) emitFrameAccess(out, "sw", "$t8", f->offset[v]);
+                break;
+            }
+            case IR_LABEL:
+                printOp(out, getOperand(interCodeList, cur->u.oneOp.op));
+                putString(out, ":\n");
+                break;
+            case IR_ASSIGN: {
+                const char* rd = defOperand(f, cur->u.assign.left);
+                pOperand right = getOperand(interCodeList, cur->u.assign.right);
+                if (right->kind == OP_CONSTANT)
+                    emitAsm(out, "li %s, %d", rd, right->u.value);
+                else
+                    loadOperand(out, f, cur->u.assign.right, rd);
+                storeDef(out, f, cur->u.assign.left);
+                break;
+            }
+            case IR_ADD:
+            case IR_SUB:
+            case IR_MUL:
+            case IR_DIV: {
+                int op1 = cur->u.binOp.op1, op2 = cur->u.binOp.op2;
+                pOperand p1 = getOperand(interCodeList, op1), p2 = getOperand(interCodeList, op2);
+                if (cur->kind == IR_ADD && p1->kind == OP_CONSTANT && p2->kind != OP_CONSTANT) {
+                    int t = op1;
+                    op1 = op2;
+                    op2 = t;
+                    p2 = p1;
+                }
+                const char* r1 = useOperand(out, f, op1, "$t8");
+                const char* rd = defOperand(f, cur->u.binOp.result);
+                if (p2->kind == OP_CONSTANT && cur->kind == IR_ADD && isImmediate(p2->u.value))
+                    emitAsm(out, "addi %s, %s, %d", rd, r1, p2->u.value);
+                else if (p2->kind == OP_CONSTANT && cur->kind == IR_SUB && isImmediate(-p2->u.value))
+                    emitAsm(out, "addi %s, %s, %d", rd, r1, -p2->u.value);
+                else {
+                    const char* r2 = useOperand(out, f, op2, "$t9");
+                    if (cur->kind == IR_DIV) {
+                        emitAsm(out, "div %s, %s", r1, r2);
+                        emitAsm(out, "mflo %s", rd);
+                    }
+                    else
+                        emitAsm(out, "%s %s, %s, %s", cur->kind == IR_ADD ? "add" : cur->kind == IR_SUB ? "sub" : "mul",
+                                rd, r1, r2);
+                }
+                storeDef(out, f, cur->u.binOp.result);
+                break;
+            }
+            case IR_GET_ADDR: {
+                const char* rd = defOperand(f, cur->u.assign.left);
+                emitAddress(out, rd, f->offset[getNode(f, cur->u.assign.right)]);
+                storeDef(out, f, cur->u.assign.left);
+                break;
+            }
+            case IR_READ_ADDR: {
+                const char* r = useOperand(out, f, cur->u.assign.right, "$t9");
+                const char* rd = defOperand(f, cur->u.assign.left);
+                emitAsm(out, "lw %s, 0(%s)", rd, r);
+                storeDef(out, f, cur->u.assign.left);
+                break;
+            }
+            case IR_WRITE_ADDR: {
+                const char* ra = useOperand(out, f, cur->u.assign.left, "$t8");
+                const char* rv = useOperand(out, f, cur->u.assign.right, "$t9");
+                emitAsm(out, "sw %s, 0(%s)", rv, ra);
+                break;
+            }
+            case IR_GOTO:
+                emitAsm(out, "j %l", getOperand(interCodeList, cur->u.oneOp.op));
+                break;
+            case IR_IF_GOTO: {
+                char* relop = getOperand(interCodeList, cur->u.ifGoto.relop)->u.name;
+                const char* r1 = useOperand(out, f, cur->u.ifGoto.x, "$t8");
+                const char* r2 = useOperand(out, f, cur->u.ifGoto.y, "$t9");
+                for (int k = 0; k < 6; k++)
+                    if (!strcmp(relops[k][0], relop))
+                        emitAsm(out, "%s %s, %s, %l", relops[k][1], r1, r2, getOperand(interCodeList, cur->u.ifGoto.z));
+                break;
+            }
+            case IR_RETURN:
+                loadOperand(out, f, cur->u.oneOp.op, "$v0");
+                emitEpilogue(out, f);
+                break;
+            case IR_CALL:
+                emitCall(out, f, i);
+                break;
+            case IR_READ:
+                emitAsm(out, "jal read");
+                emitAsm(out, "move %s, $v0", defOperand(f, cur->u.oneOp.op));
+                storeDef(out, f, cur->u.oneOp.op);
+                break;
+            case IR_WRITE:
+                loadOperand(out, f, cur->u.oneOp.op, "$a0");
+                emitAsm(out, "jal write");
+                break;
+            default:
+                // DEC has its storage in the frame, ARGs are passed by their CALL
+                break;
+        }
+    }
+    // falling off the end returns 0 like the interpreter
+    if (codes[f->cfg->last - 1].kind != IR_RETURN) {
+        emitAsm(out, "move $v0, $zero");
+        emitEpilogue(out, f);
+    }
+}
+
+void emitMips(pOutBuffer out, pInterCodeList interCodeList, pMipsStat stat) {
+    assert(out != NULL && interCodeList != NULL && stat != NULL);
+    *stat = (MipsStat){0, 0, 0, 0};
+    MipsFunc f = {.list = interCodeList, .live = newLiveness(interCodeList)};
+    f.nodeOf = (int*)malloc(sizeof(int) * f.live->keyNum);
+    f.keys = (int*)malloc(sizeof(int) * f.live->keyNum);
+    assert(f.nodeOf != NULL && f.keys != NULL);
+    for (int i = 0; i < f.live->keyNum; i++)
+        f.nodeOf[i] = -1;
+    f.edges = (EdgeSet){NULL, 0, 0, NULL};
+
+    putString(out, prelude);
+    for (int first = 0; first < interCodeList->count; ) {
+        int last = getFunctionEnd(interCodeList, first);
+        if (interCodeList->codes[first].kind != IR_FUNCTION) {
+            first = last;
+            continue;
+        }
+        f.cfg = newCfg(interCodeList, first, last);
+        computeDominators(f.cfg);
+        computeLoops(f.cfg);
+        computeLiveness(f.live, f.cfg);
+        allocateRegisters(&f, stat);
+        emitFunction(out, &f);
+        freeAllocation(&f);
+        deleteCfg(f.cfg);
+        first = last;
+    }
+
+    free(f.nodeOf);
+    free(f.keys);
+    deleteLiveness(f.live);
+}
+
+void printMips(FILE* fp, pInterCodeList interCodeList, pMipsStat stat) {
+    pOutBuffer out = newOutBuffer(fp == NULL ? stdout : fp);
+    emitMips(out, interCodeList, stat);
+    deleteOutBuffer(out);
+}
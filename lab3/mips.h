@@ -0,0 +1,22 @@
+#ifndef MIPS_H
+#define MIPS_H
+#include "cfg.h"
+
+#define MIPS_COLOR_NUM 16       // $t0-$t7 then $s0-$s7, $t8 and $t9 are left for spilled operands
+#define MIPS_SAVED_COLOR 8      // first color kept across a CALL
+#define MIPS_ARG_REG_NUM 4      // arguments past $a0-$a3 go on the stack
+
+typedef struct mipsStat* pMipsStat;
+
+typedef struct mipsStat {
+    int funcNum;
+    int varNum;         // variables competing for registers
+    int spillNum;       // of them left in the frame
+    int edgeNum;        // interference edges
+} MipsStat;
+
+// emit func
+void emitMips(pOutBuffer out, pInterCodeList interCodeList, pMipsStat stat);
+void printMips(FILE* fp, pInterCodeList interCodeList, pMipsStat stat);
+
+#endif
@@ -17,30 +17,174 @@ typedef enum nodeType
     NOT_A_TOKEN
 } NodeType;
 
+// grammar symbols of syntax.y, terminals first, then non-terminals
+#define NODE_NAMES(X) \
+    X(INT) X(FLOAT) X(ID) X(SEMI) X(COMMA) X(ASSIGNOP) X(RELOP) \
+    X(PLUS) X(MINUS) X(STAR) X(DIV) X(AND) X(OR) X(NOT) X(DOT) \
+    X(TYPE) X(LP) X(RP) X(LB) X(RB) X(LC) X(RC) \
+    X(STRUCT) X(RETURN) X(IF) X(ELSE) X(WHILE) \
+    X(Program) X(ExtDefList) X(ExtDef) X(ExtDecList) \
+    X(Specifier) X(StructSpecifier) X(OptTag) X(Tag) \
+    X(VarDec) X(FunDec) X(VarList) X(ParamDec) \
+    X(CompSt) X(StmtList) X(Stmt) \
+    X(DefList) X(Def) X(Dec) X(DecList) \
+    X(Exp) X(Args)
+
+#define NODE_NAME_ENUM(name) N_##name,
+#define NODE_NAME_STRING(name) #name,
+
+typedef enum nodeName
+{
+    NODE_NAMES(NODE_NAME_ENUM)
+} NodeName;
+
+static const char* const nodeNameString[] = { NODE_NAMES(NODE_NAME_STRING) };
+
+// production a Stmt or Exp node was reduced by, set in the syntax.y actions
+typedef enum production
+{
+    P_NONE,
+    P_STMT_EXP,         // Stmt -> Exp SEMI
+    P_STMT_COMPST,      // Stmt -> CompSt
+    P_STMT_RETURN,      // Stmt -> RETURN Exp SEMI
+    P_STMT_IF,          // Stmt -> IF LP Exp RP Stmt
+    P_STMT_IF_ELSE,     // Stmt -> IF LP Exp RP Stmt ELSE Stmt
+    P_STMT_WHILE,       // Stmt -> WHILE LP Exp RP Stmt
+    P_EXP_ASSIGNOP,     // Exp -> Exp ASSIGNOP Exp
+    P_EXP_AND,          // Exp -> Exp AND Exp
+    P_EXP_OR,           // Exp -> Exp OR Exp
+    P_EXP_RELOP,        // Exp -> Exp RELOP Exp
+    P_EXP_PLUS,         // Exp -> Exp PLUS Exp
+    P_EXP_MINUS,        // Exp -> Exp MINUS Exp
+    P_EXP_STAR,         // Exp -> Exp STAR Exp
+    P_EXP_DIV,          // Exp -> Exp DIV Exp
+    P_EXP_PAREN,        // Exp -> LP Exp RP
+    P_EXP_NEG,          // Exp -> MINUS Exp
+    P_EXP_NOT,          // Exp -> NOT Exp
+    P_EXP_CALL_ARGS,    // Exp -> ID LP Args RP
+    P_EXP_CALL,         // Exp -> ID LP RP
+    P_EXP_INDEX,        // Exp -> Exp LB Exp RB
+    P_EXP_FIELD,        // Exp -> Exp DOT ID
+    P_EXP_ID,           // Exp -> ID
+    P_EXP_INT,          // Exp -> INT
+    P_EXP_FLOAT         // Exp -> FLOAT
+} Production;
+
+// the enums share one word so the symbol pointer keeps a node at 40 bytes
 typedef struct node
 {
     int line;
-    NodeType type;
-    char* name;
+    NodeType type : 8;
+    NodeName name : 8;
+    Production prod : 16;
     char* val;
+    struct tableItem* item;     // symbol an ID resolves to, set by the semantic pass
     struct node* child;
     struct node* sibling;
 } Node;
 
 typedef Node* pNode;
 
-static inline pNode newNode(int line, NodeType type, char* name, int argc, ...)
+#define ARENA_BLOCK_SIZE 0x10000
+
+typedef struct arenaBlock* pArenaBlock;
+typedef struct arena* pArena;
+
+typedef struct arenaBlock
+{
+    pArenaBlock next;
+    size_t used;
+    size_t size;
+    char data[];
+} ArenaBlock;
+
+typedef struct arena
+{
+    pArenaBlock head;
+    size_t blockSize;
+} Arena;
+
+// owns every Node and token text of the current compilation unit
+extern pArena nodeArena;
+// when set, syntax.y passes each ExtDef here as it is reduced and frees it instead of building the tree
+extern void (*extDefHandler)(pNode extDef);
+
+static inline pArena newArena(size_t blockSize)
+{
+    pArena arena = (pArena)malloc(sizeof(Arena));
+    assert(arena != NULL);
+    arena->head = NULL;
+    arena->blockSize = blockSize;
+    return arena;
+}
+
+static inline void* arenaAlloc(pArena arena, size_t size)
+{
+    assert(arena != NULL);
+    size = (size + 7) & ~(size_t)7;
+    pArenaBlock block = arena->head;
+    if (block == NULL || block->used + size > block->size)
+    {
+        size_t blockSize = size > arena->blockSize ? size : arena->blockSize;
+        block = (pArenaBlock)malloc(sizeof(ArenaBlock) + blockSize);
+        assert(block != NULL);
+        block->used = 0;
+        block->size = blockSize;
+        block->next = arena->head;
+        arena->head = block;
+    }
+    void* p = block->data + block->used;
+    block->used += size;
+    return p;
+}
+
+static inline char* arenaString(pArena arena, char* src)
 {
-    pNode curNode = (pNode)malloc(sizeof(Node));
-    assert(curNode != NULL);
+    int length = strlen(src) + 1;
+    char* p = (char*)arenaAlloc(arena, sizeof(char) * length);
+    memcpy(p, src, length);
+    return p;
+}
+
+static inline void deleteArena(pArena arena)
+{
+    if (arena == NULL) return;
+    pArenaBlock block = arena->head;
+    while (block != NULL)
+    {
+        pArenaBlock temp = block;
+        block = block->next;
+        free(temp);
+    }
+    free(arena);
+}
+
+// drops every allocation but keeps the newest block for reuse
+static inline void clearArena(pArena arena)
+{
+    assert(arena != NULL);
+    pArenaBlock block = arena->head;
+    if (block == NULL) return;
+    while (block->next != NULL)
+    {
+        pArenaBlock temp = block->next;
+        block->next = temp->next;
+        free(temp);
+    }
+    block->used = 0;
+}
+
+static inline pNode newNode(int line, NodeType type, NodeName name, int argc, ...)
+{
+    pNode curNode = (pNode)arenaAlloc(nodeArena, sizeof(Node));
     
     curNode->line = line;
     curNode->type = type;
-    
-    int nameLength = strlen(name) + 1;
-    curNode->name = (char*)malloc(sizeof(char) * nameLength);
-    assert(curNode->name != NULL);
-    strncpy(curNode->name, name, nameLength);
+    curNode->name = name;
+    curNode->prod = P_NONE;
+    curNode->val = NULL;
+    curNode->item = NULL;
+    curNode->sibling = NULL;
 
     va_list arg_ptr;
     va_start(arg_ptr, argc);
@@ -60,44 +204,27 @@ static inline pNode newNode(int line, NodeType type, char* name, int argc, ...)
     return curNode;
 }
 
-static inline pNode newTokenNode(int line, NodeType type, char* tokenName, char* tokenText)
+static inline pNode newTokenNode(int line, NodeType type, NodeName tokenName, char* tokenText)
 {
-    pNode tokenNode = (pNode)malloc(sizeof(Node));
-    assert(tokenNode != NULL);
+    pNode tokenNode = (pNode)arenaAlloc(nodeArena, sizeof(Node));
 
     tokenNode->line = line;
     tokenNode->type = type;
-
-    int nameLength = strlen(tokenName) + 1;
-    int textLength = strlen(tokenText) + 1;
-        
-    tokenNode->name = (char*)malloc(sizeof(char) * nameLength);
-    tokenNode->val = (char*)malloc(sizeof(char) * textLength);
-
-    assert(tokenNode->name != NULL);
-    assert(tokenNode->val != NULL);
-
-    strncpy(tokenNode->name, tokenName, nameLength);
-    strncpy(tokenNode->val, tokenText, textLength);
-
+    tokenNode->name = tokenName;
+    tokenNode->prod = P_NONE;
+    tokenNode->val = arenaString(nodeArena, tokenText);
+    tokenNode->item = NULL;
     tokenNode->child = NULL;
     tokenNode->sibling = NULL;
 
     return tokenNode;
 }
 
-static inline void delNode(pNode node)
+// nodes can't be freed one by one, this releases every node of the compilation unit at once
+static inline void deleteNodes(void)
 {
-    if (node == NULL) return;
-    while (node->child != NULL)
-    {
-        pNode temp = node->child;
-        node->child = node->child->sibling;
-        delNode(temp);
-    }
-    free(node);
-    node = NULL;
-    return;
+    deleteArena(nodeArena);
+    nodeArena = NULL;
 }
 
 static inline void printTree(pNode curNode,int line)
@@ -107,7 +234,7 @@ static inline void printTree(pNode curNode,int line)
     {
         printf("  ");
     }
-    printf("%s", curNode->name);
+    printf("%s", nodeNameString[curNode->name]);
     if (curNode->type == NOT_A_TOKEN)
     {
         printf(" (%d)", curNode->line);
@@ -0,0 +1,964 @@
+#include "cfg.h"
+#include "opt.h"
+
+static boolean isConstant(pInterCodeList interCodeList, int index) {
+    return getOperand(interCodeList, index)->kind == OP_CONSTANT;
+}
+
+static int getConstant(pInterCodeList interCodeList, int index) {
+    return getOperand(interCodeList, index)->u.value;
+}
+
+// same 32 bit wrap around as the interpreter, FALSE when the result is not defined
+static boolean evalBinOp(int kind, int x, int y, int* result) {
+    switch (kind) {
+        case IR_ADD:
+            *result = (int)((unsigned)x + (unsigned)y);
+            return TRUE;
+        case IR_SUB:
+            *result = (int)((unsigned)x - (unsigned)y);
+            return TRUE;
+        case IR_MUL:
+            *result = (int)((unsigned)x * (unsigned)y);
+            return TRUE;
+        case IR_DIV:
+            if (y == 0 || y == -1) return FALSE;
+            *result = x / y;
+            return TRUE;
+        default:
+            assert(0);
+            return FALSE;
+    }
+}
+
+static boolean evalRelop(char* relop, int x, int y) {
+    if (!strcmp(relop, "==")) return x == y;
+    if (!strcmp(relop, "!=")) return x != y;
+    if (!strcmp(relop, "<")) return x < y;
+    if (!strcmp(relop, ">")) return x > y;
+    if (!strcmp(relop, "<=")) return x <= y;
+    assert(!strcmp(relop, ">="));
+    return x >= y;
+}
+
+static InterCode newAssign(int left, int right) {
+    InterCode code = {.kind = IR_ASSIGN};
+    code.u.assign.left = left;
+    code.u.assign.right = right;
+    return code;
+}
+
+// pass func
+// Known constants live until the next LABEL or FUNCTION, a variable whose address is taken is
+// never tracked since *p := x or a CALL may change it. Temps left with a constant assignment
+// and no reader are dropped afterwards.
+void foldConstants(pInterCodeList interCodeList, pPassStat stat) {
+    int varNum = updateVarKeys(interCodeList);
+    boolean* addrTaken = (boolean*)calloc(varNum, sizeof(boolean));
+    int* known = (int*)calloc(varNum, sizeof(int));
+    int* value = (int*)malloc(sizeof(int) * varNum);
+    int* readers = (int*)calloc(varNum, sizeof(int));
+    assert(addrTaken != NULL && known != NULL && value != NULL && readers != NULL);
+    int block = 1;
+
+    for (int i = 0; i < interCodeList->count; i++)
+        if (interCodeList->codes[i].kind == IR_GET_ADDR) {
+            int key = getVarKey(interCodeList, interCodeList->codes[i].u.assign.right);
+            if (key >= 0) addrTaken[key] = TRUE;
+        }
+
+    for (int i = 0; i < interCodeList->count; i++) {
+        pInterCode cur = &interCodeList->codes[i];
+        if (cur->kind == IR_LABEL || cur->kind == IR_FUNCTION) {
+            block++;
+            continue;
+        }
+
+        // replace reads of known variables, addresses of *x stay variables
+        int* uses[3];
+        int useNum = getCodeUses(cur, uses);
+        for (int j = 0; j < useNum; j++) {
+            if ((cur->kind == IR_READ_ADDR || cur->kind == IR_WRITE_ADDR) && j == 0) continue;
+            int key = getVarKey(interCodeList, *uses[j]);
+            if (key >= 0 && known[key] == block) {
+                *uses[j] = newConstant(interCodeList, value[key]);
+                stat->changed++;
+            }
+        }
+
+        switch (cur->kind) {
+            case IR_ADD:
+            case IR_SUB:
+            case IR_MUL:
+            case IR_DIV: {
+                int op1 = cur->u.binOp.op1, op2 = cur->u.binOp.op2, result;
+                boolean c1 = isConstant(interCodeList, op1), c2 = isConstant(interCodeList, op2);
+                int v1 = c1 ? getConstant(interCodeList, op1) : 0, v2 = c2 ? getConstant(interCodeList, op2) : 0;
+                if (c1 && c2) {
+                    if (!evalBinOp(cur->kind, v1, v2, &result)) break;
+                    *cur = newAssign(cur->u.binOp.result, newConstant(interCodeList, result));
+                }
+                // x + 0, 0 + x, x - 0, x * 1, 1 * x, x / 1
+                else if (c2 && ((v2 == 0 && (cur->kind == IR_ADD || cur->kind == IR_SUB)) ||
+                                (v2 == 1 && (cur->kind == IR_MUL || cur->kind == IR_DIV))))
+                    *cur = newAssign(cur->u.binOp.result, op1);
+                else if (c1 && ((v1 == 0 && cur->kind == IR_ADD) || (v1 == 1 && cur->kind == IR_MUL)))
+                    *cur = newAssign(cur->u.binOp.result, op2);
+                // x * 0, 0 * x
+                else if (cur->kind == IR_MUL && ((c1 && v1 == 0) || (c2 && v2 == 0)))
+                    *cur = newAssign(cur->u.binOp.result, c1 ? op1 : op2);
+                else
+                    break;
+                stat->changed++;
+                break;
+            }
+            case IR_IF_GOTO: {
+                int x = cur->u.ifGoto.x, y = cur->u.ifGoto.y;
+                if (!isConstant(interCodeList, x) || !isConstant(interCodeList, y)) break;
+                char* relop = getOperand(interCodeList, cur->u.ifGoto.relop)->u.name;
+                if (evalRelop(relop, getConstant(interCodeList, x), getConstant(interCodeList, y))) {
+                    int label = cur->u.ifGoto.z;
+                    *cur = (InterCode){.kind = IR_GOTO};
+                    cur->u.oneOp.op = label;
+                    stat->changed++;
+                }
+                else {
+                    cur->kind = IR_NOP;
+                    stat->removed++;
+                }
+                break;
+            }
+            default:
+                break;
+        }
+
+        int key = getVarKey(interCodeList, getCodeDef(cur));
+        if (key < 0) continue;
+        if (cur->kind == IR_ASSIGN && isConstant(interCodeList, cur->u.assign.right) && !addrTaken[key]) {
+            known[key] = block;
+            value[key] = getConstant(interCodeList, cur->u.assign.right);
+        }
+        else
+            known[key] = 0;
+    }
+
+    // temps only ever assigned a constant that nobody reads any more
+    for (int i = 0; i < interCodeList->count; i++) {
+        pInterCode cur = &interCodeList->codes[i];
+        int* uses[3];
+        int useNum = getCodeUses(cur, uses);
+        for (int j = 0; j < useNum; j++) {
+            int key = getVarKey(interCodeList, *uses[j]);
+            if (key >= 0) readers[key]++;
+        }
+        if (cur->kind == IR_GET_ADDR || cur->kind == IR_DEC) {
+            int key = getVarKey(interCodeList, cur->kind == IR_DEC ? cur->u.dec.op : cur->u.assign.right);
+            if (key >= 0) readers[key]++;
+        }
+    }
+    for (int i = 0; i < interCodeList->count; i++) {
+        pInterCode cur = &interCodeList->codes[i];
+        if (cur->kind != IR_ASSIGN || !isConstant(interCodeList, cur->u.assign.right)) continue;
+        int key = getVarKey(interCodeList, cur->u.assign.left);
+        if (key > 0 && key < interCodeList->varBase && readers[key] == 0) {
+            cur->kind = IR_NOP;
+            stat->removed++;
+        }
+    }
+    compactInterCodes(interCodeList);
+
+    free(addrTaken);
+    free(known);
+    free(value);
+    free(readers);
+}
+
+static int nextCode(pInterCodeList interCodeList, int i) {
+    i++;
+    while (i < interCodeList->count && interCodeList->codes[i].kind == IR_NOP)
+        i++;
+    return i;
+}
+
+static int* getJumpTarget(pInterCode code) {
+    if (code->kind == IR_GOTO) return &code->u.oneOp.op;
+    if (code->kind == IR_IF_GOTO) return &code->u.ifGoto.z;
+    return NULL;
+}
+
+static int getLabelNo(pInterCodeList interCodeList, int index) {
+    return getOperand(interCodeList, index)->no;
+}
+
+// whether the run of labels starting at i defines label no, i.e. a jump there from before i falls through
+static boolean isLabelInRun(pInterCodeList interCodeList, int i, int no) {
+    for (; i < interCodeList->count; i = nextCode(interCodeList, i)) {
+        pInterCode cur = &interCodeList->codes[i];
+        if (cur->kind == IR_NOP) continue;
+        if (cur->kind != IR_LABEL) return FALSE;
+        if (getLabelNo(interCodeList, cur->u.oneOp.op) == no) return TRUE;
+    }
+    return FALSE;
+}
+
+static int invertRelop(pInterCodeList interCodeList, int index) {
+    static const char* relops[][2] = {{"==", "!="}, {"!=", "=="}, {"<", ">="}, {">=", "<"}, {">", "<="}, {"<=", ">"}};
+    char* relop = getOperand(interCodeList, index)->u.name;
+    for (int i = 0; i < 6; i++)
+        if (!strcmp(relops[i][0], relop)) {
+            pOperand p = allocOperand(interCodeList);
+            p->kind = OP_RELOP;
+            p->u.name = internName(interCodeList->names, (char*)relops[i][1]);
+            return p->index;
+        }
+    assert(0);
+    return index;
+}
+
+// codes after a GOTO or RETURN up to the next label, DECs are kept since they only reserve storage
+static void removeDeadCodes(pInterCodeList interCodeList, int i, pPassStat stat) {
+    for (i = nextCode(interCodeList, i); i < interCodeList->count; i = nextCode(interCodeList, i)) {
+        pInterCode cur = &interCodeList->codes[i];
+        if (cur->kind == IR_LABEL || cur->kind == IR_FUNCTION) return;
+        if (cur->kind == IR_DEC) continue;
+        cur->kind = IR_NOP;
+        stat->removed++;
+    }
+}
+
+// Every jump goes straight to the end of its GOTO chain and to the first label of a run of labels.
+// Jumps to the code right after them go, IF a GOTO b LABEL a becomes IF !a GOTO b LABEL a, codes
+// behind a jump and blocks the CFG cannot reach are dropped, and so are labels nobody jumps to.
+void threadJumps(pInterCodeList interCodeList, pPassStat stat) {
+    int labelNum = interCodeList->labelNum;
+    int* labelPos = (int*)malloc(sizeof(int) * labelNum);
+    int* target = (int*)malloc(sizeof(int) * labelNum);
+    int* refs = (int*)malloc(sizeof(int) * labelNum);
+    assert(labelPos != NULL && target != NULL && refs != NULL);
+    int removed = -1;
+
+    while (removed != stat->removed) {
+        removed = stat->removed;
+        pInterCode codes = interCodeList->codes;
+        for (int i = 0; i < labelNum; i++)
+            labelPos[i] = -1;
+        for (int i = 0; i < interCodeList->count; i++)
+            if (codes[i].kind == IR_LABEL)
+                labelPos[getLabelNo(interCodeList, codes[i].u.oneOp.op)] = i;
+
+        for (int no = 1; no < labelNum; no++) {
+            if (labelPos[no] < 0) continue;
+            // follow LABEL x GOTO y, the hop limit also ends GOTO cycles
+            int cur = no;
+            for (int hops = 0; hops < 0x40; hops++) {
+                int j = labelPos[cur];
+                while (j < interCodeList->count && (codes[j].kind == IR_LABEL || codes[j].kind == IR_NOP))
+                    j++;
+                if (j == interCodeList->count || codes[j].kind != IR_GOTO) break;
+                int next = getLabelNo(interCodeList, codes[j].u.oneOp.op);
+                if (next == cur || labelPos[next] < 0) break;
+                cur = next;
+            }
+            int k = labelPos[cur];
+            for (int j = k - 1; j >= 0 && (codes[j].kind == IR_LABEL || codes[j].kind == IR_NOP); j--)
+                if (codes[j].kind == IR_LABEL) k = j;
+            target[no] = codes[k].u.oneOp.op;
+        }
+
+        for (int i = 0; i < interCodeList->count; i++) {
+            int* label = getJumpTarget(&codes[i]);
+            if (label == NULL) continue;
+            int no = getLabelNo(interCodeList, *label);
+            assert(labelPos[no] >= 0);
+            if (getLabelNo(interCodeList, target[no]) != no) {
+                *label = target[no];
+                stat->changed++;
+            }
+        }
+
+        for (int i = 0; i < interCodeList->count; i++) {
+            pInterCode cur = &codes[i];
+            int next = nextCode(interCodeList, i);
+            if (cur->kind == IR_GOTO && isLabelInRun(interCodeList, next, getLabelNo(interCodeList, cur->u.oneOp.op))) {
+                cur->kind = IR_NOP;
+                stat->removed++;
+            }
+            else if (cur->kind == IR_IF_GOTO) {
+                int no = getLabelNo(interCodeList, cur->u.ifGoto.z);
+                if (isLabelInRun(interCodeList, next, no)) {
+                    cur->kind = IR_NOP;
+                    stat->removed++;
+                }
+                else if (next < interCodeList->count && codes[next].kind == IR_GOTO &&
+                         isLabelInRun(interCodeList, nextCode(interCodeList, next), no)) {
+                    cur->u.ifGoto.relop = invertRelop(interCodeList, cur->u.ifGoto.relop);
+                    cur->u.ifGoto.z = codes[next].u.oneOp.op;
+                    codes[next].kind = IR_NOP;
+                    stat->changed++;
+                    stat->removed++;
+                }
+            }
+            if (cur->kind == IR_GOTO || cur->kind == IR_RETURN)
+                removeDeadCodes(interCodeList, i, stat);
+        }
+
+        // blocks without a path from the entry, their labels go in the next round
+        for (int i = 0; i < interCodeList->count; ) {
+            int last = getFunctionEnd(interCodeList, i);
+            if (codes[i].kind != IR_FUNCTION) {
+                i = last;
+                continue;
+            }
+            pCfg p = newCfg(interCodeList, i, last);
+            for (int j = 0; j < p->blockNum; j++) {
+                if (p->blocks[j].rpo >= 0) continue;
+                for (int k = p->blocks[j].first; k < p->blocks[j].last; k++)
+                    if (codes[k].kind != IR_DEC && codes[k].kind != IR_NOP) {
+                        codes[k].kind = IR_NOP;
+                        stat->removed++;
+                    }
+            }
+            deleteCfg(p);
+            i = last;
+        }
+
+        for (int i = 0; i < labelNum; i++)
+            refs[i] = 0;
+        for (int i = 0; i < interCodeList->count; i++) {
+            int* label = getJumpTarget(&codes[i]);
+            if (label != NULL && codes[i].kind != IR_NOP) refs[getLabelNo(interCodeList, *label)]++;
+        }
+        for (int i = 0; i < interCodeList->count; i++)
+            if (codes[i].kind == IR_LABEL && refs[getLabelNo(interCodeList, codes[i].u.oneOp.op)] == 0) {
+                codes[i].kind = IR_NOP;
+                stat->removed++;
+            }
+        compactInterCodes(interCodeList);
+    }
+
+    free(labelPos);
+    free(target);
+    free(refs);
+}
+
+typedef struct valueEntry {
+    int stamp;          // block the entry belongs to, older ones count as empty
+    int kind, a, b;     // IR_NOP with a constant in a, else an operation on value numbers
+    int value;
+    int holder;         // operand holding the value, 0 for constants
+} ValueEntry;
+
+typedef struct valueTable {
+    pInterCodeList list;
+    ValueEntry* entries;
+    int mask;
+    int stamp;
+    int* valueOf;       // value number of a key, valid when valueStamp matches the block
+    int* valueStamp;
+    int valueNum;
+} ValueTable;
+
+static ValueEntry* findValue(ValueTable* t, int kind, int a, int b) {
+    unsigned h = ((unsigned)kind * 0x9e3779b1u) ^ ((unsigned)a * 0x85ebca6bu) ^ ((unsigned)b * 0xc2b2ae35u);
+    for (int i = h & t->mask; ; i = (i + 1) & t->mask) {
+        ValueEntry* e = &t->entries[i];
+        if (e->stamp != t->stamp) {
+            *e = (ValueEntry){.stamp = t->stamp, .kind = kind, .a = a, .b = b, .value = 0, .holder = 0};
+            return e;
+        }
+        if (e->kind == kind && e->a == a && e->b == b) return e;
+    }
+}
+
+static int getValue(ValueTable* t, int index) {
+    pOperand op = getOperand(t->list, index);
+    if (op->kind == OP_CONSTANT) {
+        ValueEntry* e = findValue(t, IR_NOP, op->u.value, 0);
+        if (e->value == 0) e->value = ++t->valueNum;
+        return e->value;
+    }
+    int key = getVarKey(t->list, index);
+    assert(key >= 0);
+    if (t->valueStamp[key] != t->stamp) {
+        t->valueStamp[key] = t->stamp;
+        t->valueOf[key] = ++t->valueNum;
+    }
+    return t->valueOf[key];
+}
+
+static void setValue(ValueTable* t, int key, int value) {
+    t->valueStamp[key] = t->stamp;
+    t->valueOf[key] = value;
+}
+
+// Value numbering within blocks over ADD, SUB, MUL and GET_ADDR. x := y shares y's number, so
+// t4 := i * #4 t6 := t5 + t4 after an earlier a[i] matches the first computation and becomes a
+// copy of the temp that still holds it, copy propagation and DCE then drop the copies.
+void eliminateCommonExps(pInterCodeList interCodeList, pPassStat stat) {
+    int keyNum = updateVarKeys(interCodeList), maxBlock = 0, size = 0x10;
+    for (int i = 0, len = 0; i < interCodeList->count; i++) {
+        int kind = interCodeList->codes[i].kind;
+        len = kind == IR_LABEL || kind == IR_FUNCTION ? 0 : len + 1;
+        if (len > maxBlock) maxBlock = len;
+    }
+    // a block makes at most three entries per code, constants included
+    while (size < maxBlock * 6)
+        size <<= 1;
+    ValueTable t = {.list = interCodeList, .mask = size - 1, .stamp = 1, .valueNum = 0};
+    t.entries = (ValueEntry*)calloc(size, sizeof(ValueEntry));
+    t.valueOf = (int*)malloc(sizeof(int) * keyNum);
+    t.valueStamp = (int*)calloc(keyNum, sizeof(int));
+    assert(t.entries != NULL && t.valueOf != NULL && t.valueStamp != NULL);
+
+    for (int i = 0; i < interCodeList->count; i++) {
+        pInterCode cur = &interCodeList->codes[i];
+        if (cur->kind == IR_LABEL || cur->kind == IR_FUNCTION) {
+            t.stamp++;
+            continue;
+        }
+        int key = getVarKey(interCodeList, getCodeDef(cur));
+        if (key < 0) continue;
+        ValueEntry* e = NULL;
+        switch (cur->kind) {
+            case IR_ASSIGN:
+                setValue(&t, key, getValue(&t, cur->u.assign.right));
+                continue;
+            case IR_GET_ADDR:
+                e = findValue(&t, IR_GET_ADDR, getValue(&t, cur->u.assign.right), 0);
+                break;
+            case IR_ADD:
+            case IR_SUB:
+            case IR_MUL: {
+                int a = getValue(&t, cur->u.binOp.op1), b = getValue(&t, cur->u.binOp.op2);
+                if (cur->kind != IR_SUB && a > b) {
+                    int c = a;
+                    a = b;
+                    b = c;
+                }
+                e = findValue(&t, cur->kind, a, b);
+                break;
+            }
+            default:
+                break;
+        }
+        if (e != NULL && e->value != 0) {
+            int holder = getVarKey(interCodeList, e->holder);
+            if (t.valueStamp[holder] == t.stamp && t.valueOf[holder] == e->value) {
+                *cur = newAssign(getCodeDef(cur), e->holder);
+                setValue(&t, key, e->value);
+                stat->changed++;
+                continue;
+            }
+        }
+        setValue(&t, key, ++t.valueNum);
+        if (e != NULL) {
+            e->value = t.valueNum;
+            e->holder = getCodeDef(cur);
+        }
+    }
+
+    free(t.entries);
+    free(t.valueOf);
+    free(t.valueStamp);
+}
+
+static boolean isBlockBound(int kind) {
+    return kind == IR_LABEL || kind == IR_FUNCTION || kind == IR_GOTO || kind == IR_IF_GOTO || kind == IR_RETURN;
+}
+
+static boolean mentionsKey(pInterCodeList interCodeList, pInterCode code, int key) {
+    if (getVarKey(interCodeList, getCodeDef(code)) == key) return TRUE;
+    int* uses[3];
+    int useNum = getCodeUses(code, uses);
+    for (int j = 0; j < useNum; j++)
+        if (getVarKey(interCodeList, *uses[j]) == key) return TRUE;
+    return FALSE;
+}
+
+// t := e ... x := t becomes x := e when t is a temp written and read once and x is not touched in
+// between within the block, so READ t1 n := t1 is READ n. After that, reads of x following
+// x := y in a block read y until either is written again, the dead copies go with DCE.
+void propagateCopies(pInterCodeList interCodeList, pPassStat stat) {
+    int keyNum = updateVarKeys(interCodeList);
+    int* defs = (int*)calloc(keyNum, sizeof(int));
+    int* reads = (int*)calloc(keyNum, sizeof(int));
+    boolean* addrTaken = (boolean*)calloc(keyNum, sizeof(boolean));
+    assert(defs != NULL && reads != NULL && addrTaken != NULL);
+    pInterCode codes = interCodeList->codes;
+    for (int i = 0; i < interCodeList->count; i++) {
+        int* uses[3];
+        int useNum = getCodeUses(&codes[i], uses);
+        for (int j = 0; j < useNum; j++) {
+            int key = getVarKey(interCodeList, *uses[j]);
+            if (key >= 0) reads[key]++;
+        }
+        int key = getVarKey(interCodeList, getCodeDef(&codes[i]));
+        if (key >= 0) defs[key]++;
+        if (codes[i].kind == IR_GET_ADDR) {
+            key = getVarKey(interCodeList, codes[i].u.assign.right);
+            if (key >= 0) addrTaken[key] = TRUE;
+        }
+    }
+
+    for (int j = 0; j < interCodeList->count; j++) {
+        pInterCode copy = &codes[j];
+        if (copy->kind != IR_ASSIGN) continue;
+        int t = getVarKey(interCodeList, copy->u.assign.right), x = getVarKey(interCodeList, copy->u.assign.left);
+        if (t <= 0 || t >= interCodeList->varBase || defs[t] != 1 || reads[t] != 1 || x < 0 || x == t || addrTaken[x])
+            continue;
+        for (int i = j - 1; i >= 0 && !isBlockBound(codes[i].kind); i--) {
+            int* def = getCodeDefSlot(&codes[i]);
+            if (def != NULL && getVarKey(interCodeList, *def) == t) {
+                *def = copy->u.assign.left;
+                copy->kind = IR_NOP;
+                stat->changed++;
+                stat->removed++;
+                break;
+            }
+            if (mentionsKey(interCodeList, &codes[i], x)) break;
+        }
+    }
+
+    // a copy x := y holds while version[y] is what it was at the copy
+    int* copyOf = (int*)malloc(sizeof(int) * keyNum);
+    int* copyBlock = (int*)calloc(keyNum, sizeof(int));
+    int* source = (int*)malloc(sizeof(int) * keyNum);
+    int* sourceVersion = (int*)malloc(sizeof(int) * keyNum);
+    int* version = (int*)calloc(keyNum, sizeof(int));
+    assert(copyOf != NULL && copyBlock != NULL && source != NULL && sourceVersion != NULL && version != NULL);
+    int block = 1;
+    for (int i = 0; i < interCodeList->count; i++) {
+        pInterCode cur = &codes[i];
+        if (cur->kind == IR_LABEL || cur->kind == IR_FUNCTION) {
+            block++;
+            continue;
+        }
+        int* uses[3];
+        int useNum = getCodeUses(cur, uses);
+        for (int j = 0; j < useNum; j++) {
+            int key = getVarKey(interCodeList, *uses[j]);
+            if (key >= 0 && copyBlock[key] == block && version[source[key]] == sourceVersion[key]) {
+                *uses[j] = copyOf[key];
+                stat->changed++;
+            }
+        }
+        int key = getVarKey(interCodeList, getCodeDef(cur));
+        if (key < 0) continue;
+        version[key]++;
+        copyBlock[key] = 0;
+        int y = cur->kind == IR_ASSIGN ? getVarKey(interCodeList, cur->u.assign.right) : -1;
+        if (y >= 0 && y != key && !addrTaken[key] && !addrTaken[y]) {
+            copyBlock[key] = block;
+            copyOf[key] = cur->u.assign.right;
+            source[key] = y;
+            sourceVersion[key] = version[y];
+        }
+    }
+    compactInterCodes(interCodeList);
+
+    free(defs);
+    free(reads);
+    free(addrTaken);
+    free(copyOf);
+    free(copyBlock);
+    free(source);
+    free(sourceVersion);
+    free(version);
+}
+
+typedef struct codeMove {
+    int pos;            // the code goes right before original code pos
+    int seq;            // keeps the codes for one pos in source order
+    InterCode code;
+} CodeMove;
+
+// code at becomes result := s, s holding key * value of the constant c
+typedef struct reduction {
+    int at;
+    int result;
+    int key, c;
+    int s;
+} Reduction;
+
+typedef struct loopMotion {
+    pInterCodeList list;
+    int* state;         // per code, CODE_HOISTED or CODE_REDUCED once handled
+    int* globalDefs;
+    int* loopDefs;      // defs of a key in the current loop, valid when defStamp matches
+    int* lastDef;
+    int* defStamp;
+    int* blockStamp;
+    int stamp;
+    CodeMove* moves;
+    int moveNum, moveSize;
+    Reduction* reduced;
+    int reducedNum, reducedSize;
+} LoopMotion;
+
+enum { CODE_KEPT, CODE_HOISTED, CODE_REDUCED };
+
+static void addMove(LoopMotion* m, int pos, int seq, InterCode code) {
+    if (m->moveNum == m->moveSize) {
+        m->moveSize = m->moveSize == 0 ? 0x40 : m->moveSize * 2;
+        m->moves = (CodeMove*)realloc(m->moves, sizeof(CodeMove) * m->moveSize);
+        assert(m->moves != NULL);
+    }
+    m->moves[m->moveNum++] = (CodeMove){.pos = pos, .seq = seq, .code = code};
+}
+
+static int compareMoves(const void* a, const void* b) {
+    const CodeMove *x = (const CodeMove*)a, *y = (const CodeMove*)b;
+    if (x->pos != y->pos) return x->pos < y->pos ? -1 : 1;
+    return x->seq < y->seq ? -1 : x->seq > y->seq;
+}
+
+// numbered above every key of the round, which never looks the new temps up
+static int newLoopTemp(pInterCodeList interCodeList) {
+    pOperand p = allocOperand(interCodeList);
+    p->kind = OP_VARIABLE;
+    p->u.name = NULL;
+    if (interCodeList->tempVarNum < interCodeList->varBase)
+        interCodeList->tempVarNum = interCodeList->varBase;
+    p->no = interCodeList->tempVarNum++;
+    return p->index;
+}
+
+static InterCode newBinOp(int kind, int result, int op1, int op2) {
+    InterCode code = {.kind = kind};
+    code.u.binOp.result = result;
+    code.u.binOp.op1 = op1;
+    code.u.binOp.op2 = op2;
+    return code;
+}
+
+static boolean isInvariant(LoopMotion* m, int index) {
+    int key = getVarKey(m->list, index);
+    return key < 0 || m->defStamp[key] != m->stamp || m->loopDefs[key] == 0;
+}
+
+// the only def of key in the loop is key := key + c or key := key - c, returns the step
+static boolean getInductionStep(LoopMotion* m, int key, int* step) {
+    if (key < 0 || m->defStamp[key] != m->stamp || m->loopDefs[key] != 1) return FALSE;
+    pInterCode def = &m->list->codes[m->lastDef[key]];
+    if (m->state[m->lastDef[key]] != CODE_KEPT) return FALSE;
+    int op1 = def->u.binOp.op1, op2 = def->u.binOp.op2;
+    if (def->kind == IR_ADD && getVarKey(m->list, op2) == key && isConstant(m->list, op1)) {
+        *step = getConstant(m->list, op1);
+        return TRUE;
+    }
+    if ((def->kind != IR_ADD && def->kind != IR_SUB) || getVarKey(m->list, op1) != key || !isConstant(m->list, op2))
+        return FALSE;
+    *step = def->kind == IR_ADD ? getConstant(m->list, op2) : (int)(0u - (unsigned)getConstant(m->list, op2));
+    return TRUE;
+}
+
+// A loop is handled when its header is entered from outside only by falling through from the
+// block above it, the codes for the preheader then go right before the header's labels.
+static void moveLoopCodes(LoopMotion* m, pCfg p, pLoop loop, pPassStat stat) {
+    pInterCodeList interCodeList = m->list;
+    pInterCode codes = interCodeList->codes;
+    pBasicBlock header = &p->blocks[loop->header];
+    m->stamp++;
+    for (int k = 0; k < loop->blockNum; k++)
+        m->blockStamp[loop->blocks[k]] = m->stamp;
+    if (loop->header == 0) return;
+    for (int k = 0; k < header->predNum; k++)
+        if (m->blockStamp[header->preds[k]] != m->stamp && header->preds[k] != loop->header - 1) return;
+    if (m->blockStamp[loop->header - 1] == m->stamp) return;
+    pInterCode above = &codes[p->blocks[loop->header - 1].last - 1];
+    int* target = getJumpTarget(above);
+    if (above->kind == IR_GOTO || above->kind == IR_RETURN) return;
+    if (target != NULL)
+        for (int i = header->first; i < header->last && codes[i].kind == IR_LABEL; i++)
+            if (getLabelNo(interCodeList, codes[i].u.oneOp.op) == getLabelNo(interCodeList, *target)) return;
+    int pos = header->first;
+
+    for (int k = 0; k < loop->blockNum; k++) {
+        pBasicBlock block = &p->blocks[loop->blocks[k]];
+        for (int i = block->first; i < block->last; i++) {
+            int key = getVarKey(interCodeList, getCodeDef(&codes[i]));
+            if (key < 0 || m->state[i] == CODE_HOISTED) continue;
+            if (m->defStamp[key] != m->stamp) {
+                m->defStamp[key] = m->stamp;
+                m->loopDefs[key] = 0;
+            }
+            m->loopDefs[key]++;
+            m->lastDef[key] = i;
+        }
+    }
+
+    // temps defined once by an operation on invariants, which never traps
+    boolean changed = TRUE;
+    while (changed) {
+        changed = FALSE;
+        for (int k = 0; k < loop->blockNum; k++) {
+            pBasicBlock block = &p->blocks[loop->blocks[k]];
+            for (int i = block->first; i < block->last; i++) {
+                pInterCode cur = &codes[i];
+                if (m->state[i] != CODE_KEPT) continue;
+                if (cur->kind != IR_GET_ADDR &&
+                    ((cur->kind != IR_ADD && cur->kind != IR_SUB && cur->kind != IR_MUL) ||
+                     !isInvariant(m, cur->u.binOp.op1) || !isInvariant(m, cur->u.binOp.op2)))
+                    continue;
+                int key = getVarKey(interCodeList, getCodeDef(cur));
+                if (key <= 0 || key >= interCodeList->varBase || m->globalDefs[key] != 1) continue;
+                m->state[i] = CODE_HOISTED;
+                m->loopDefs[key] = 0;
+                addMove(m, pos, i, *cur);
+                stat->changed++;
+                changed = TRUE;
+            }
+        }
+    }
+
+    // t := i * c with i := i + d the only def of i becomes t := s, s := i * c goes to the
+    // preheader and s := s + c * d right after the def of i
+    int reducedFrom = m->reducedNum;
+    for (int k = 0; k < loop->blockNum; k++) {
+        pBasicBlock block = &p->blocks[loop->blocks[k]];
+        for (int i = block->first; i < block->last; i++) {
+            pInterCode cur = &codes[i];
+            if (m->state[i] != CODE_KEPT || cur->kind != IR_MUL) continue;
+            int iv = cur->u.binOp.op1, c = cur->u.binOp.op2, step;
+            if (isConstant(interCodeList, iv)) {
+                iv = cur->u.binOp.op2;
+                c = cur->u.binOp.op1;
+            }
+            if (!isConstant(interCodeList, c)) continue;
+            int key = getVarKey(interCodeList, iv);
+            if (!getInductionStep(m, key, &step)) continue;
+            int s = 0;
+            for (int j = reducedFrom; j < m->reducedNum; j++)
+                if (m->reduced[j].key == key && getConstant(interCodeList, m->reduced[j].c) == getConstant(interCodeList, c))
+                    s = m->reduced[j].s;
+            if (s == 0) {
+                s = newLoopTemp(interCodeList);
+                addMove(m, pos, i, newBinOp(IR_MUL, s, iv, c));
+                int inc = newConstant(interCodeList, (int)((unsigned)step * (unsigned)getConstant(interCodeList, c)));
+                addMove(m, m->lastDef[key] + 1, m->lastDef[key],
+                        newBinOp(IR_ADD, s, s, inc));
+            }
+            if (m->reducedNum == m->reducedSize) {
+                m->reducedSize = m->reducedSize == 0 ? 0x40 : m->reducedSize * 2;
+                m->reduced = (Reduction*)realloc(m->reduced, sizeof(Reduction) * m->reducedSize);
+                assert(m->reduced != NULL);
+            }
+            m->reduced[m->reducedNum++] = (Reduction){.at = i, .result = cur->u.binOp.result, .key = key, .c = c, .s = s};
+            m->state[i] = CODE_REDUCED;
+            stat->changed++;
+        }
+    }
+}
+
+// Loop invariant code motion and strength reduction of induction variable multiplications,
+// outer loops first so an invariant of several loops goes out of all at once. Every round
+// moves codes of the current layout, the next one sees the loops the preheaders are now in.
+void moveLoopInvariants(pInterCodeList interCodeList, pPassStat stat) {
+    LoopMotion m = {.list = interCodeList, .stamp = 0, .moves = NULL, .moveNum = 0, .moveSize = 0,
+                    .reduced = NULL, .reducedNum = 0, .reducedSize = 0};
+    for (int round = 0; round < 8; round++) {
+        int keyNum = updateVarKeys(interCodeList);
+        m.state = (int*)calloc(interCodeList->count, sizeof(int));
+        m.globalDefs = (int*)calloc(keyNum, sizeof(int));
+        m.loopDefs = (int*)malloc(sizeof(int) * keyNum);
+        m.lastDef = (int*)malloc(sizeof(int) * keyNum);
+        m.defStamp = (int*)calloc(keyNum, sizeof(int));
+        assert(m.state != NULL && m.globalDefs != NULL && m.loopDefs != NULL && m.lastDef != NULL && m.defStamp != NULL);
+        for (int i = 0; i < interCodeList->count; i++) {
+            int key = getVarKey(interCodeList, getCodeDef(&interCodeList->codes[i]));
+            if (key >= 0) m.globalDefs[key]++;
+        }
+        m.moveNum = 0;
+        m.reducedNum = 0;
+
+        for (int first = 0; first < interCodeList->count; ) {
+            int last = getFunctionEnd(interCodeList, first);
+            if (interCodeList->codes[first].kind != IR_FUNCTION) {
+                first = last;
+                continue;
+            }
+            pCfg p = newCfg(interCodeList, first, last);
+            computeDominators(p);
+            computeLoops(p);
+            if (p->loopNum > 0) {
+                m.blockStamp = (int*)calloc(p->blockNum, sizeof(int));
+                assert(m.blockStamp != NULL);
+                for (int k = 0; k < p->loopNum; k++)
+                    moveLoopCodes(&m, p, &p->loops[k], stat);
+                free(m.blockStamp);
+            }
+            deleteCfg(p);
+            first = last;
+        }
+
+        for (int j = 0; j < m.reducedNum; j++)
+            interCodeList->codes[m.reduced[j].at] = newAssign(m.reduced[j].result, m.reduced[j].s);
+        int count = interCodeList->count, moveNum = m.moveNum;
+        if (moveNum > 0) {
+            qsort(m.moves, moveNum, sizeof(CodeMove), compareMoves);
+            pInterCode old = interCodeList->codes;
+            interCodeList->codes = (pInterCode)malloc(sizeof(InterCode) * interCodeList->capacity);
+            assert(interCodeList->codes != NULL);
+            interCodeList->count = 0;
+            for (int i = 0, j = 0; i <= count; i++) {
+                for (; j < moveNum && m.moves[j].pos == i; j++)
+                    addInterCode(interCodeList, m.moves[j].code);
+                if (i < count && m.state[i] != CODE_HOISTED)
+                    addInterCode(interCodeList, old[i]);
+            }
+            free(old);
+        }
+
+        free(m.state);
+        free(m.globalDefs);
+        free(m.loopDefs);
+        free(m.lastDef);
+        free(m.defStamp);
+        if (moveNum == 0) break;
+    }
+    free(m.moves);
+    free(m.reduced);
+}
+
+// codes whose only effect is their def, CALL and READ keep theirs
+static boolean isPure(int kind) {
+    switch (kind) {
+        case IR_ASSIGN:
+        case IR_ADD:
+        case IR_SUB:
+        case IR_MUL:
+        case IR_DIV:
+        case IR_GET_ADDR:
+        case IR_READ_ADDR:
+            return TRUE;
+        default:
+            return FALSE;
+    }
+}
+
+// one round over a function, returns the number of codes dropped
+static int removeDeadDefs(pLiveness l, boolean* live, boolean* addrTaken) {
+    pCfg p = l->cfg;
+    pInterCode codes = l->list->codes;
+    int removed = 0;
+    computeLiveness(l, p);
+    for (int b = 0; b < p->blockNum; b++) {
+        for (int k = 0; k < l->globalNum; k++)
+            live[l->globals[k]] = isLiveOut(l, b, l->globals[k]);
+        for (int i = p->blocks[b].last - 1; i >= p->blocks[b].first; i--) {
+            pInterCode cur = &codes[i];
+            int key = getVarKey(l->list, getCodeDef(cur));
+            if (key >= 0 && isPure(cur->kind) && !live[key] && !addrTaken[key]) {
+                cur->kind = IR_NOP;
+                removed++;
+                continue;
+            }
+            if (key >= 0) live[key] = FALSE;
+            int* uses;
+            int useNum = getLiveUses(l, i, &uses);
+            for (int j = 0; j < useNum; j++)
+                live[uses[j]] = TRUE;
+        }
+        for (int i = p->blocks[b].first; i < p->blocks[b].last; i++) {
+            int* uses;
+            int useNum = getLiveUses(l, i, &uses);
+            for (int j = 0; j < useNum; j++)
+                live[uses[j]] = FALSE;
+        }
+        for (int k = 0; k < l->globalNum; k++)
+            live[l->globals[k]] = FALSE;
+    }
+    return removed;
+}
+
+// Backward liveness per function, rerun until a round drops nothing. Variables whose address is
+// taken are always live.
+void eliminateDeadCodes(pInterCodeList interCodeList, pPassStat stat) {
+    pLiveness l = newLiveness(interCodeList);
+    boolean* live = (boolean*)calloc(l->keyNum, sizeof(boolean));
+    boolean* addrTaken = (boolean*)calloc(l->keyNum, sizeof(boolean));
+    assert(live != NULL && addrTaken != NULL);
+    for (int i = 0; i < interCodeList->count; i++)
+        if (interCodeList->codes[i].kind == IR_GET_ADDR) {
+            int key = getVarKey(interCodeList, interCodeList->codes[i].u.assign.right);
+            if (key >= 0) addrTaken[key] = TRUE;
+        }
+
+    for (int first = 0; first < interCodeList->count; ) {
+        int last = getFunctionEnd(interCodeList, first);
+        if (interCodeList->codes[first].kind != IR_FUNCTION) {
+            first = last;
+            continue;
+        }
+        pCfg p = newCfg(interCodeList, first, last);
+        l->cfg = p;
+        int removed;
+        while ((removed = removeDeadDefs(l, live, addrTaken)) > 0)
+            stat->removed += removed;
+        deleteCfg(p);
+        first = last;
+    }
+    compactInterCodes(interCodeList);
+
+    free(live);
+    free(addrTaken);
+    deleteLiveness(l);
+}
+
+// distinct temps the codes still mention
+static int countTemps(pInterCodeList interCodeList) {
+    int keyNum = updateVarKeys(interCodeList), count = 0;
+    boolean* seen = (boolean*)calloc(keyNum, sizeof(boolean));
+    assert(seen != NULL);
+    for (int i = 0; i < interCodeList->count; i++) {
+        pInterCode cur = &interCodeList->codes[i];
+        int* uses[3];
+        int useNum = getCodeUses(cur, uses);
+        int keys[4] = {getVarKey(interCodeList, getCodeDef(cur))};
+        for (int j = 0; j < useNum; j++)
+            keys[j + 1] = getVarKey(interCodeList, *uses[j]);
+        for (int j = 0; j <= useNum; j++)
+            if (keys[j] > 0 && keys[j] < interCodeList->varBase && !seen[keys[j]]) {
+                seen[keys[j]] = TRUE;
+                count++;
+            }
+    }
+    free(seen);
+    return count;
+}
+
+// driver func
+typedef void (*Pass)(pInterCodeList interCodeList, pPassStat stat);
+
+static void runPass(pInterCodeList interCodeList, pOptStat stat, const char* name, Pass pass) {
+    assert(stat->passNum < OPT_PASS_MAX);
+    pPassStat p = &stat->passes[stat->passNum++];
+    p->name = name;
+    p->changed = 0;
+    p->removed = 0;
+    pass(interCodeList, p);
+}
+
+void optimize(pInterCodeList interCodeList, pOptStat stat) {
+    assert(interCodeList != NULL && stat != NULL);
+    stat->before = interCodeList->count;
+    stat->tempsBefore = countTemps(interCodeList);
+    stat->passNum = 0;
+    runPass(interCodeList, stat, "constant folding", foldConstants);
+    runPass(interCodeList, stat, "common subexpressions", eliminateCommonExps);
+    runPass(interCodeList, stat, "copy propagation", propagateCopies);
+    runPass(interCodeList, stat, "jump threading", threadJumps);
+    runPass(interCodeList, stat, "loop invariants", moveLoopInvariants);
+    runPass(interCodeList, stat, "copy propagation", propagateCopies);
+    runPass(interCodeList, stat, "dead code elimination", eliminateDeadCodes);
+    stat->after = interCodeList->count;
+    stat->tempsAfter = countTemps(interCodeList);
+}
+
+void printOptStat(FILE* fp, pOptStat stat) {
+    for (int i = 0; i < stat->passNum; i++)
+        fprintf(fp, "%s: %d changed, %d removed\n", stat->passes[i].name, stat->passes[i].changed,
+                stat->passes[i].removed);
+    fprintf(fp, "codes: %d -> %d\n", stat->before, stat->after);
+    fprintf(fp, "temps: %d -> %d\n", stat->tempsBefore, stat->tempsAfter);
+}
@@ -0,0 +1,37 @@
+#ifndef OPT_H
+#define OPT_H
+#include "inter.h"
+
+#define OPT_PASS_MAX 0x10
+
+typedef struct passStat* pPassStat;
+typedef struct optStat* pOptStat;
+
+typedef struct passStat {
+    const char* name;
+    int changed;        // codes rewritten in place
+    int removed;        // codes dropped
+} PassStat;
+
+typedef struct optStat {
+    int before;
+    int after;
+    int tempsBefore;
+    int tempsAfter;
+    int passNum;
+    PassStat passes[OPT_PASS_MAX];
+} OptStat;
+
+// pass func
+void foldConstants(pInterCodeList interCodeList, pPassStat stat);
+void eliminateCommonExps(pInterCodeList interCodeList, pPassStat stat);
+void propagateCopies(pInterCodeList interCodeList, pPassStat stat);
+void threadJumps(pInterCodeList interCodeList, pPassStat stat);
+void moveLoopInvariants(pInterCodeList interCodeList, pPassStat stat);
+void eliminateDeadCodes(pInterCodeList interCodeList, pPassStat stat);
+
+// driver func
+void optimize(pInterCodeList interCodeList, pOptStat stat);
+void printOptStat(FILE* fp, pOptStat stat);
+
+#endif
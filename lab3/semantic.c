@@ -1,14 +1,19 @@
 #include "semantic.h"
 
 pTable table;
+pTypeTable typeTable;
+int semError = 0;
 
 // Global function
+// walks the ExtDefList chain, ExtDef checks everything below it
 void traverseTree(pNode node) {
     if (node == NULL) return;
-    if (!strcmp(node->name, "ExtDef")) 
-        ExtDef(node);
-    traverseTree(node->child);
-    traverseTree(node->sibling);
+    if (node->name != N_ExtDefList) {
+        traverseTree(node->child);
+        return;
+    }
+    for (pNode p = node; p != NULL; p = p->child->sibling)
+        ExtDef(p->child);
 }
 
 // Type functions
@@ -22,52 +27,37 @@ pType newType(Kind kind, int argc, ...) {
         case BASIC:
             va_start(arg_ptr, argc);
             p->u.basic = va_arg(arg_ptr, BasicType);
+            p->size = 4;
             break;
         case ARRAY:
             va_start(arg_ptr, argc);
             p->u.array.elem = va_arg(arg_ptr, pType);
             p->u.array.size = va_arg(arg_ptr, int);
+            p->u.array.sibling = NULL;
+            p->size = p->u.array.elem ? p->u.array.size * p->u.array.elem->size : 0;
             break;
         case STRUCTURE:
             va_start(arg_ptr, argc);
             p->u.structure.structName = va_arg(arg_ptr, char*);
             p->u.structure.field = va_arg(arg_ptr, pFieldList);
+            p->u.structure.fieldHash = NULL;
+            p->u.structure.fieldMask = 0;
+            p->size = 0;
             break;
         case FUNCTION:
             va_start(arg_ptr, argc);
             p->u.function.argc = va_arg(arg_ptr, int);
             p->u.function.argv = va_arg(arg_ptr, pFieldList);
             p->u.function.returnType = va_arg(arg_ptr, pType);
+            p->size = 0;
             break;
     }
     va_end(arg_ptr);
-    return p;
-}
 
-pType copyType(pType src) {
-    if (src == NULL) return NULL;
-    pType p = (pType)malloc(sizeof(Type));
-    assert(p != NULL);
-    p->kind = src->kind;
-    assert(p->kind == BASIC || p->kind == ARRAY || p->kind == STRUCTURE || p->kind == FUNCTION);
-    switch (p->kind) {
-        case BASIC:
-            p->u.basic = src->u.basic;
-            break;
-        case ARRAY:
-            p->u.array.elem = copyType(src->u.array.elem);
-            p->u.array.size = src->u.array.size;
-            break;
-        case STRUCTURE:
-            p->u.structure.structName = newString(src->u.structure.structName);
-            p->u.structure.field = copyFieldList(src->u.structure.field);
-            break;
-        case FUNCTION:
-            p->u.function.argc = src->u.function.argc;
-            p->u.function.argv = copyFieldList(src->u.function.argv);
-            p->u.function.returnType = copyType(src->u.function.returnType);
-            break;
-    }
+    // every type is owned by the type table
+    p->arrayOf = NULL;
+    p->next = typeTable->head;
+    typeTable->head = p;
     return p;
 }
 
@@ -75,12 +65,10 @@ void deleteType(pType type) {
     assert(type != NULL);
     assert(type->kind == BASIC || type->kind == ARRAY || type->kind == STRUCTURE || type->kind == FUNCTION);
     pFieldList temp = NULL;
+    // element and return types are owned by the type table, only names and field lists belong to this type
     switch (type->kind) {
         case BASIC:
-            break;
         case ARRAY:
-            deleteType(type->u.array.elem);
-            type->u.array.elem = NULL;
             break;
         case STRUCTURE:
             if (type->u.structure.structName)
@@ -94,10 +82,10 @@ void deleteType(pType type) {
                 deleteFieldList(tDelete);
             }
             type->u.structure.field = NULL;
+            free(type->u.structure.fieldHash);
+            type->u.structure.fieldHash = NULL;
             break;
         case FUNCTION:
-            deleteType(type->u.function.returnType);
-            type->u.function.returnType = NULL;
             temp = type->u.function.argv;
             while (temp) {
                 pFieldList tDelete = temp;
@@ -115,19 +103,95 @@ boolean checkType(pType type1, pType type2) {
         return TRUE;
     if (type1->kind == FUNCTION || type2->kind == FUNCTION)
         return FALSE;
-    if (type1->kind != type2->kind)
-        return FALSE;
-    else {
-        assert(type1->kind == BASIC || type1->kind == ARRAY || type1->kind == STRUCTURE);
-        switch (type1->kind) {
-            case BASIC:
-                return type1->u.basic == type2->u.basic;
-            case ARRAY:
-                return checkType(type1->u.array.elem, type2->u.array.elem);
-            case STRUCTURE:
-                return !strcmp(type1->u.structure.structName, type2->u.structure.structName);
-        }
+    // types are interned, only arrays of different sizes can match without being the same type
+    if (type1 == type2)
+        return TRUE;
+    if (type1->kind == ARRAY && type2->kind == ARRAY)
+        return checkType(type1->u.array.elem, type2->u.array.elem);
+    return FALSE;
+}
+
+// TypeTable functions
+pTypeTable newTypeTable() {
+    pTypeTable p = (pTypeTable)malloc(sizeof(TypeTable));
+    assert(p != NULL);
+    p->head = NULL;
+    p->basicType[INT_TYPE] = NULL;
+    p->basicType[FLOAT_TYPE] = NULL;
+    return p;
+}
+
+void deleteTypeTable(pTypeTable typeTable) {
+    assert(typeTable != NULL);
+    pType temp = typeTable->head;
+    while (temp) {
+        pType tDelete = temp;
+        temp = temp->next;
+        deleteType(tDelete);
     }
+    free(typeTable);
+}
+
+pType getBasicType(BasicType basic) {
+    if (typeTable->basicType[basic] == NULL)
+        typeTable->basicType[basic] = newType(BASIC, 1, basic);
+    return typeTable->basicType[basic];
+}
+
+pType getArrayType(pType elem, int size) {
+    // arrays of an undefined type only come up in error recovery, they are not shared
+    if (elem == NULL)
+        return newType(ARRAY, 2, NULL, size);
+    pType p = elem->arrayOf;
+    while (p) {
+        if (p->u.array.size == size)
+            return p;
+        p = p->u.array.sibling;
+    }
+    p = newType(ARRAY, 2, elem, size);
+    p->u.array.sibling = elem->arrayOf;
+    elem->arrayOf = p;
+    return p;
+}
+
+// field offsets and the struct's size, computed once after its DefList
+void layoutStruct(pType type) {
+    assert(type != NULL && type->kind == STRUCTURE);
+    int size = 0, fieldNum = 0;
+    for (pFieldList p = type->u.structure.field; p != NULL; p = p->tail) {
+        p->offset = size;
+        size += p->type ? p->type->size : 0;
+        fieldNum++;
+    }
+    type->size = size;
+    if (fieldNum < FIELD_HASH_MIN) return;
+
+    unsigned capacity = 1;
+    while (capacity < 2u * fieldNum) capacity <<= 1;
+    pFieldList* hash = (pFieldList*)calloc(capacity, sizeof(pFieldList));
+    assert(hash != NULL);
+    // redefined fields never made it into the list, names are unique
+    for (pFieldList p = type->u.structure.field; p != NULL; p = p->tail) {
+        unsigned i = getHashCode(p->name) & (capacity - 1);
+        while (hash[i]) i = (i + 1) & (capacity - 1);
+        hash[i] = p;
+    }
+    type->u.structure.fieldHash = hash;
+    type->u.structure.fieldMask = capacity - 1;
+}
+
+pFieldList findField(pType type, char* name) {
+    assert(type != NULL && type->kind == STRUCTURE);
+    pFieldList* hash = type->u.structure.fieldHash;
+    if (hash == NULL) {
+        pFieldList p = type->u.structure.field;
+        while (p && strcmp(p->name, name)) p = p->tail;
+        return p;
+    }
+    unsigned mask = type->u.structure.fieldMask;
+    for (unsigned i = getHashCode(name) & mask; hash[i]; i = (i + 1) & mask)
+        if (!strcmp(hash[i]->name, name)) return hash[i];
+    return NULL;
 }
 
 // FieldList functions
@@ -137,6 +201,7 @@ pFieldList newFieldList(char* newName, pType newType) {
     p->name = newString(newName);
     p->type = newType;
     p->isArg = FALSE;
+    p->offset = 0;
     p->tail = NULL;
     return p;
 }
@@ -146,14 +211,15 @@ pFieldList copyFieldList(pFieldList src) {
     pFieldList head = NULL, cur = NULL;
     pFieldList temp = src;
 
+    // types are shared, only the list nodes are copied
     while (temp) {
         if (!head) {
-            head = newFieldList(temp->name, copyType(temp->type));
+            head = newFieldList(temp->name, temp->type);
             cur = head;
             temp = temp->tail;
         } 
         else {
-            cur->tail = newFieldList(temp->name, copyType(temp->type));
+            cur->tail = newFieldList(temp->name, temp->type);
             cur = cur->tail;
             temp = temp->tail;
         }
@@ -167,8 +233,6 @@ void deleteFieldList(pFieldList fieldList) {
         free(fieldList->name);
         fieldList->name = NULL;
     }
-    if (fieldList->type)
-        deleteType(fieldList->type);
     fieldList->type = NULL;
     free(fieldList);
 }
@@ -184,6 +248,7 @@ void setFieldListName(pFieldList p, char* newName) {
 pItem newItem(int symbolDepth, pFieldList pfield) {
     pItem p = (pItem)malloc(sizeof(TableItem));
     assert(p != NULL);
+    p->hashCode = 0;
     p->symbolDepth = symbolDepth;
     p->field = pfield;
     p->nextHash = NULL;
@@ -203,25 +268,35 @@ boolean isStructDef(pItem src) {
         return FALSE;
     if (src->field->type->kind != STRUCTURE)
         return FALSE;
-    if (src->field->type->u.structure.structName)
+    // the definition is filed under the struct's own name, no variable of the type can share it
+    if (src->field->type->u.structure.structName == NULL)
         return FALSE;
-    return TRUE;
+    return !strcmp(src->field->name, src->field->type->u.structure.structName);
+}
+
+// a rejected declaration, its ID resolves to whatever the name already means
+void discardItem(pNode varDec, pItem item) {
+    pNode id = varDec;
+    while (id->child) id = id->child;
+    id->item = searchTableItem(table, item->field->name);
+    deleteItem(item);
 }
 
 // Hash functions
-pHash newHash() {
+pHash newHash(unsigned size) {
+    assert((size & (size - 1)) == 0);
     pHash p = (pHash)malloc(sizeof(HashTable));
     assert(p != NULL);
-    p->hashArray = (pItem*)malloc(sizeof(pItem) * HASH_TABLE_SIZE);
+    p->hashArray = (pItem*)calloc(size, sizeof(pItem));
     assert(p->hashArray != NULL);
-    for (int i = 0; i < HASH_TABLE_SIZE; i++)
-        p->hashArray[i] = NULL;
+    p->size = size;
+    p->count = 0;
     return p;
 }
 
 void deleteHash(pHash hash) {
     assert(hash != NULL);
-    for (int i = 0; i < HASH_TABLE_SIZE; i++) {
+    for (unsigned i = 0; i < hash->size; i++) {
         pItem temp = hash->hashArray[i];
         while (temp) {
             pItem tdelete = temp;
@@ -235,12 +310,44 @@ void deleteHash(pHash hash) {
     free(hash);
 }
 
-pItem getHashHead(pHash hash, int index) {
+void resizeHash(pHash hash, unsigned newSize) {
+    assert(hash != NULL);
+    assert((newSize & (newSize - 1)) == 0);
+    pItem* newArray = (pItem*)calloc(newSize, sizeof(pItem));
+    pItem* tails = (pItem*)calloc(newSize, sizeof(pItem));
+    assert(newArray != NULL && tails != NULL);
+    // append in chain order, so shadowing items stay ahead of the ones they shadow
+    for (unsigned i = 0; i < hash->size; i++) {
+        pItem temp = hash->hashArray[i];
+        while (temp) {
+            pItem next = temp->nextHash;
+            unsigned index = temp->hashCode & (newSize - 1);
+            temp->nextHash = NULL;
+            if (tails[index])
+                tails[index]->nextHash = temp;
+            else
+                newArray[index] = temp;
+            tails[index] = temp;
+            temp = next;
+        }
+    }
+    free(tails);
+    free(hash->hashArray);
+    hash->hashArray = newArray;
+    hash->size = newSize;
+}
+
+unsigned getHashIndex(pHash hash, unsigned hashCode) {
+    assert(hash != NULL);
+    return hashCode & (hash->size - 1);
+}
+
+pItem getHashHead(pHash hash, unsigned index) {
     assert(hash != NULL);
     return hash->hashArray[index];
 }
 
-void setHashHead(pHash hash, int index, pItem newVal) {
+void setHashHead(pHash hash, unsigned index, pItem newVal) {
     assert(hash != NULL);
     hash->hashArray[index] = newVal;
 }
@@ -249,11 +356,10 @@ void setHashHead(pHash hash, int index, pItem newVal) {
 pStack newStack() {
     pStack p = (pStack)malloc(sizeof(Stack));
     assert(p != NULL);
-    p->stackArray = (pItem*)malloc(sizeof(pItem) * HASH_TABLE_SIZE);
+    p->stackArray = (pItem*)calloc(STACK_INIT_DEPTH, sizeof(pItem));
     assert(p->stackArray != NULL);
-    for (int i = 0; i < HASH_TABLE_SIZE; i++)
-        p->stackArray[i] = NULL;
     p->curStackDepth = 0;
+    p->capacity = STACK_INIT_DEPTH;
     return p;
 }
 
@@ -262,12 +368,20 @@ void deleteStack(pStack stack) {
     free(stack->stackArray);
     stack->stackArray = NULL;
     stack->curStackDepth = 0;
+    stack->capacity = 0;
     free(stack);
 }
 
 void addStackDepth(pStack stack) {
     assert(stack != NULL);
     stack->curStackDepth++;
+    if (stack->curStackDepth == stack->capacity) {
+        int newCapacity = stack->capacity * 2;
+        stack->stackArray = (pItem*)realloc(stack->stackArray, sizeof(pItem) * newCapacity);
+        assert(stack->stackArray != NULL);
+        memset(stack->stackArray + stack->capacity, 0, sizeof(pItem) * (newCapacity - stack->capacity));
+        stack->capacity = newCapacity;
+    }
 }
 
 void minusStackDepth(pStack stack) {
@@ -289,14 +403,15 @@ void setCurDepthStackHead(pStack stack, pItem newVal) {
 pTable initTable() {
     pTable table = (pTable)malloc(sizeof(Table));
     assert(table != NULL);
-    table->hash = newHash();
+    table->hash = newHash(HASH_TABLE_INIT_SIZE);
     table->stack = newStack();
     table->unNamedStructNum = 0;
+    typeTable = newTypeTable();
 
     // add func 'read' and 'write'
-    pItem readFun = newItem(0, newFieldList(newString("read"), newType(FUNCTION, 3, 0, NULL, newType(BASIC, 1, INT_TYPE))));
+    pItem readFun = newItem(0, newFieldList("read", newType(FUNCTION, 3, 0, NULL, getBasicType(INT_TYPE))));
 
-    pItem writeFun = newItem(0, newFieldList(newString("write"), newType(FUNCTION, 3, 1, newFieldList("arg1", newType(BASIC, 1, INT_TYPE)), newType(BASIC, 1, INT_TYPE))));
+    pItem writeFun = newItem(0, newFieldList("write", newType(FUNCTION, 3, 1, newFieldList("arg1", getBasicType(INT_TYPE)), getBasicType(INT_TYPE))));
 
     addTableItem(table, readFun);
     addTableItem(table, writeFun);
@@ -309,17 +424,17 @@ void deleteTable(pTable table) {
     table->hash = NULL;
     deleteStack(table->stack);
     table->stack = NULL;
+    deleteTypeTable(typeTable);
+    typeTable = NULL;
     free(table);
     table = NULL;
 };
 
 pItem searchTableItem(pTable table, char* name) {
     unsigned hashCode = getHashCode(name);
-    pItem temp = getHashHead(table->hash, hashCode);
-    if (temp == NULL) 
-        return NULL;
+    pItem temp = getHashHead(table->hash, getHashIndex(table->hash, hashCode));
     while (temp) {
-        if (!strcmp(temp->field->name, name)) 
+        if (temp->hashCode == hashCode && !strcmp(temp->field->name, name)) 
             return temp;
         temp = temp->nextHash;
     }
@@ -330,8 +445,9 @@ boolean checkTableItemConflict(pTable table, pItem item) {
     pItem temp = searchTableItem(table, item->field->name);
     if (temp == NULL) 
         return FALSE;
+    unsigned hashCode = temp->hashCode;
     while (temp) {
-        if (!strcmp(temp->field->name, item->field->name)) {
+        if (temp->hashCode == hashCode && !strcmp(temp->field->name, item->field->name)) {
             if (temp->field->type->kind == STRUCTURE || item->field->type->kind == STRUCTURE)
                 return TRUE;
             if (temp->symbolDepth == table->stack->curStackDepth) 
@@ -344,24 +460,28 @@ boolean checkTableItemConflict(pTable table, pItem item) {
 
 void addTableItem(pTable table, pItem item) {
     assert(table != NULL && item != NULL);
-    unsigned hashCode = getHashCode(item->field->name);
     pHash hash = table->hash;
     pStack stack = table->stack;
+    item->hashCode = getHashCode(item->field->name);
 
     item->nextSymbol = getCurDepthStackHead(stack);
     setCurDepthStackHead(stack, item);
 
-    item->nextHash = getHashHead(hash, hashCode);
-    setHashHead(hash, hashCode, item);
+    if (hash->count + 1 > hash->size * HASH_TABLE_MAX_LOAD)
+        resizeHash(hash, hash->size * 2);
+    unsigned index = getHashIndex(hash, item->hashCode);
+    item->nextHash = getHashHead(hash, index);
+    setHashHead(hash, index, item);
+    hash->count++;
 }
 
 void deleteTableItem(pTable table, pItem item) {
     assert(table != NULL && item != NULL);
-    unsigned hashCode = getHashCode(item->field->name);
-    if (item == getHashHead(table->hash, hashCode))
-        setHashHead(table->hash, hashCode, item->nextHash);
+    unsigned index = getHashIndex(table->hash, item->hashCode);
+    if (item == getHashHead(table->hash, index))
+        setHashHead(table->hash, index, item->nextHash);
     else {
-        pItem cur = getHashHead(table->hash, hashCode);
+        pItem cur = getHashHead(table->hash, index);
         pItem last = cur;
         while (cur != item) {
             last = cur;
@@ -369,6 +489,7 @@ void deleteTableItem(pTable table, pItem item) {
         }
         last->nextHash = cur->nextHash;
     }
+    table->hash->count--;
     deleteItem(item);
 }
 
@@ -385,6 +506,13 @@ void clearCurDepthStackList(pTable table) {
     minusStackDepth(stack);
 }
 
+// pops every scope opened above depth together with its symbols
+void clearStackAbove(pTable table, int depth) {
+    assert(table != NULL);
+    while (table->stack->curStackDepth > depth)
+        clearCurDepthStackList(table);
+}
+
 // Generate symbol table functions
 void ExtDef(pNode node) {
     assert(node != NULL);
@@ -392,21 +520,18 @@ void ExtDef(pNode node) {
     //         | Specifier SEMI
     //         | Specifier FunDec CompSt
     pType specifierType = Specifier(node->child);
-    char* secondName = node->child->sibling->name;
+    NodeName secondName = node->child->sibling->name;
 
     // ExtDef -> Specifier ExtDecList SEMI
-    if (!strcmp(secondName, "ExtDecList"))
+    if (secondName == N_ExtDecList)
         ExtDecList(node->child->sibling, specifierType);
         
     // ExtDef -> Specifier FunDec CompSt
-    else if (!strcmp(secondName, "FunDec")) {
+    else if (secondName == N_FunDec) {
         FunDec(node->child->sibling, specifierType);
         CompSt(node->child->sibling->sibling, specifierType);
     }
     
-    if (specifierType) 
-        deleteType(specifierType);
-    
     // ExtDef -> Specifier SEMI
     // this situation has no meaning
     // or is struct define(have been processe in Specifier())
@@ -423,7 +548,7 @@ void ExtDecList(pNode node, pType specifier) {
             char msg[100] = {0};
             sprintf(msg, "Redefined variable \"%s\".", item->field->name);
             pError(REDEF_VAR, temp->line, msg);
-            deleteItem(item);
+            discardItem(temp->child, item);
         } 
         else
             addTableItem(table, item);
@@ -441,11 +566,11 @@ pType Specifier(pNode node) {
 
     pNode t = node->child;
     // Specifier -> TYPE
-    if (!strcmp(t->name, "TYPE")) {
+    if (t->name == N_TYPE) {
         if (!strcmp(t->val, "float"))
-            return newType(BASIC, 1, FLOAT_TYPE);
+            return getBasicType(FLOAT_TYPE);
         else
-            return newType(BASIC, 1, INT_TYPE);
+            return getBasicType(INT_TYPE);
     }
     // Specifier -> StructSpecifier
     else
@@ -462,9 +587,10 @@ pType StructSpecifier(pNode node) {
     pType returnType = NULL;
     pNode t = node->child->sibling;
     // StructSpecifier->STRUCT OptTag LC DefList RC
-    if (strcmp(t->name, "Tag")) {
-        pItem structItem = newItem(table->stack->curStackDepth, newFieldList("", newType(STRUCTURE, 2, NULL, NULL)));
-        if (!strcmp(t->name, "OptTag")) {
+    if (t->name != N_Tag) {
+        pType structType = newType(STRUCTURE, 2, NULL, NULL);
+        pItem structItem = newItem(table->stack->curStackDepth, newFieldList("", structType));
+        if (t->name == N_OptTag) {
             setFieldListName(structItem->field, t->child->val);
             t = t->sibling;
         }
@@ -475,8 +601,9 @@ pType StructSpecifier(pNode node) {
             setFieldListName(structItem->field, structName);
         }
         
-        if (!strcmp(t->sibling->name, "DefList"))
+        if (t->sibling->name == N_DefList)
             DefList(t->sibling, structItem);
+        layoutStruct(structType);
 
         if (checkTableItemConflict(table, structItem)) {
             char msg[100] = {0};
@@ -485,8 +612,9 @@ pType StructSpecifier(pNode node) {
             deleteItem(structItem);
         } 
         else {
-            returnType = newType(STRUCTURE, 2, newString(structItem->field->name), copyFieldList(structItem->field->type->u.structure.field));
-            if (!strcmp(node->child->sibling->name, "OptTag"))
+            structType->u.structure.structName = newString(structItem->field->name);
+            returnType = structType;
+            if (node->child->sibling->name == N_OptTag)
                 addTableItem(table, structItem);
             // OptTag -> e
             else
@@ -503,7 +631,7 @@ pType StructSpecifier(pNode node) {
             pError(UNDEF_STRUCT, node->line, msg);
         } 
         else
-            returnType = newType(STRUCTURE, 2, newString(structItem->field->name), copyFieldList(structItem->field->type->u.structure.field));
+            returnType = structItem->field->type;
     }
     return returnType;
 }
@@ -515,16 +643,17 @@ pItem VarDec(pNode node, pType specifier) {
     pNode id = node;
     while (id->child) id = id->child;
     pItem p = newItem(table->stack->curStackDepth, newFieldList(id->val, NULL));
+    id->item = p;
 
     // VarDec -> ID
-    if (!strcmp(node->child->name, "ID"))
-        p->field->type = copyType(specifier);
+    if (node->child->name == N_ID)
+        p->field->type = specifier;
     // VarDec -> VarDec LB INT RB
     else {
         pNode varDec = node->child;
         pType temp = specifier;
         while (varDec->sibling) {
-            p->field->type = newType(ARRAY, 2, copyType(temp), atoi(varDec->sibling->sibling->val));
+            p->field->type = getArrayType(temp, atoi(varDec->sibling->sibling->val));
             temp = p->field->type;
             varDec = varDec->child;
         }
@@ -536,10 +665,10 @@ void FunDec(pNode node, pType returnType) {
     assert(node != NULL);
     // FunDec -> ID LP VarList RP
     //         | ID LP RP
-    pItem p = newItem(table->stack->curStackDepth, newFieldList(node->child->val, newType(FUNCTION, 3, 0, NULL, copyType(returnType))));
+    pItem p = newItem(table->stack->curStackDepth, newFieldList(node->child->val, newType(FUNCTION, 3, 0, NULL, returnType)));
 
     // FunDec -> ID LP VarList RP
-    if (!strcmp(node->child->sibling->sibling->name, "VarList"))
+    if (node->child->sibling->sibling->name == N_VarList)
         VarList(node->child->sibling->sibling, p);
 
     // FunDec -> ID LP RP don't need process
@@ -549,11 +678,14 @@ void FunDec(pNode node, pType returnType) {
         char msg[100] = {0};
         sprintf(msg, "Redefined function \"%s\".", p->field->name);
         pError(REDEF_FUNC, node->line, msg);
+        node->child->item = searchTableItem(table, p->field->name);
         deleteItem(p);
         p = NULL;
     } 
-    else
+    else {
         addTableItem(table, p);
+        node->child->item = p;
+    }
 }
 
 void VarList(pNode node, pItem func) {
@@ -591,13 +723,11 @@ pFieldList ParamDec(pNode node) {
     // ParamDec -> Specifier VarDec
     pType specifierType = Specifier(node->child);
     pItem p = VarDec(node->child->sibling, specifierType);
-    if (specifierType) 
-        deleteType(specifierType);
     if (checkTableItemConflict(table, p)) {
         char msg[100] = {0};
         sprintf(msg, "Redefined variable \"%s\".", p->field->name);
         pError(REDEF_VAR, node->line, msg);
-        deleteItem(p);
+        discardItem(node->child->sibling, p);
         return NULL;
     } 
     else {
@@ -612,11 +742,11 @@ void CompSt(pNode node, pType returnType) {
     // CompSt -> LC DefList StmtList RC
     addStackDepth(table->stack);
     pNode temp = node->child->sibling;
-    if (!strcmp(temp->name, "DefList")) {
+    if (temp->name == N_DefList) {
         DefList(temp, NULL);
         temp = temp->sibling;
     }
-    if (!strcmp(temp->name, "StmtList"))
+    if (temp->name == N_StmtList)
         StmtList(temp, returnType);
 }
 
@@ -639,41 +769,47 @@ void Stmt(pNode node, pType returnType) {
     //       | WHILE LP Exp RP Stmt
 
     pType expType = NULL;
-    // Stmt -> Exp SEMI
-    if (!strcmp(node->child->name, "Exp")) 
-        expType = Exp(node->child);
+    switch (node->prod) {
+        // Stmt -> Exp SEMI
+        case P_STMT_EXP:
+            expType = Exp(node->child);
+            break;
+
+        // Stmt -> CompSt
+        case P_STMT_COMPST:
+            CompSt(node->child, returnType);
+            break;
 
-    // Stmt -> CompSt
-    else if (!strcmp(node->child->name, "CompSt"))
-        CompSt(node->child, returnType);
+        // Stmt -> RETURN Exp SEMI
+        case P_STMT_RETURN:
+            expType = Exp(node->child->sibling);
 
-    // Stmt -> RETURN Exp SEMI
-    else if (!strcmp(node->child->name, "RETURN")) {
-        expType = Exp(node->child->sibling);
+            // check return type
+            if (!checkType(returnType, expType))
+                pError(TYPE_MISMATCH_RETURN, node->line, "Type mismatched for return.");
+            break;
 
-        // check return type
-        if (!checkType(returnType, expType))
-            pError(TYPE_MISMATCH_RETURN, node->line, "Type mismatched for return.");
-    }
+        // Stmt -> IF LP Exp RP Stmt
+        //       | IF LP Exp RP Stmt ELSE Stmt
+        case P_STMT_IF:
+        case P_STMT_IF_ELSE: {
+            pNode stmt = node->child->sibling->sibling->sibling->sibling;
+            expType = Exp(node->child->sibling->sibling);
+            Stmt(stmt, returnType);
+            if (node->prod == P_STMT_IF_ELSE) 
+                Stmt(stmt->sibling->sibling, returnType);
+            break;
+        }
 
-    // Stmt -> IF LP Exp RP Stmt
-    else if (!strcmp(node->child->name, "IF")) {
-        pNode stmt = node->child->sibling->sibling->sibling->sibling;
-        expType = Exp(node->child->sibling->sibling);
-        Stmt(stmt, returnType);
-        // Stmt -> IF LP Exp RP Stmt ELSE Stmt
-        if (stmt->sibling != NULL) 
-            Stmt(stmt->sibling->sibling, returnType);
-    }
+        // Stmt -> WHILE LP Exp RP Stmt
+        case P_STMT_WHILE:
+            expType = Exp(node->child->sibling->sibling);
+            Stmt(node->child->sibling->sibling->sibling->sibling, returnType);
+            break;
 
-    // Stmt -> WHILE LP Exp RP Stmt
-    else if (!strcmp(node->child->name, "WHILE")) {
-        expType = Exp(node->child->sibling->sibling);
-        Stmt(node->child->sibling->sibling->sibling->sibling, returnType);
+        default:
+            assert(0);
     }
-
-    if (expType) 
-        deleteType(expType);
 }
 
 void DefList(pNode node, pItem structInfo) {
@@ -691,8 +827,6 @@ void Def(pNode node, pItem structInfo) {
     pType dectype = Specifier(node->child);
     
     DecList(node->child->sibling, dectype, structInfo);
-    if (dectype) 
-        deleteType(dectype);
 }
 
 void DecList(pNode node, pType specifier, pItem structInfo) {
@@ -726,7 +860,7 @@ void Dec(pNode node, pType specifier, pItem structInfo) {
                     char msg[100] = {0};
                     sprintf(msg, "Redefined field \"%s\".", decitem->field->name);
                     pError(REDEF_FEILD, node->line, msg);
-                    deleteItem(decitem);
+                    discardItem(node->child, decitem);
                     return;
                 } 
                 else {
@@ -746,7 +880,7 @@ void Dec(pNode node, pType specifier, pItem structInfo) {
                 char msg[100] = {0};
                 sprintf(msg, "Redefined variable \"%s\".", decitem->field->name);
                 pError(REDEF_VAR, node->line, msg);
-                deleteItem(decitem);
+                discardItem(node->child, decitem);
             } 
             else
                 addTableItem(table, decitem);
@@ -763,20 +897,18 @@ void Dec(pNode node, pType specifier, pItem structInfo) {
                 char msg[100] = {0};
                 sprintf(msg, "Redefined variable \"%s\".", decitem->field->name);
                 pError(REDEF_VAR, node->line, msg);
-                deleteItem(decitem);
+                discardItem(node->child, decitem);
+                return;
             }
-            if (!checkType(decitem->field->type, exptype)) {
+            // a bad initializer still declares the variable, only arrays can't be initialized at all
+            if (!checkType(decitem->field->type, exptype))
                 pError(TYPE_MISMATCH_ASSIGN, node->line, "Type mismatched for assignment.");
-                deleteItem(decitem);
-            }
             if (decitem->field->type && decitem->field->type->kind == ARRAY) {
                 pError(TYPE_MISMATCH_ASSIGN, node->line, "Illegal initialize variable.");
-                deleteItem(decitem);
+                discardItem(node->child, decitem);
             } 
             else
                 addTableItem(table, decitem);
-            if (exptype) 
-                deleteType(exptype);
         }
     }
 }
@@ -802,177 +934,181 @@ pType Exp(pNode node) {
     //      | INT
     //      | FLOAT
     pNode t = node->child;
-    if (!strcmp(t->name, "Exp")) {
-        if (strcmp(t->sibling->name, "LB") && strcmp(t->sibling->name, "DOT")) {
+    switch (node->prod) {
+        // Exp -> Exp ASSIGNOP Exp
+        case P_EXP_ASSIGNOP: {
             pType p1 = Exp(t);
             pType p2 = Exp(t->sibling->sibling);
             pType returnType = NULL;
 
-            // Exp -> Exp ASSIGNOP Exp
-            if (!strcmp(t->sibling->name, "ASSIGNOP")) {
-                pNode tchild = t->child;
-
-                if (!strcmp(tchild->name, "FLOAT") || !strcmp(tchild->name, "INT"))                    
-                    pError(LEFT_VAR_ASSIGN, t->line, "The left-hand side of an assignment must be "
-                           "avariable.");
-                else if (!strcmp(tchild->name, "ID") || !strcmp(tchild->sibling->name, "LB") || !strcmp(tchild->sibling->name, "DOT")) {
+            switch (t->prod) {
+                case P_EXP_ID:
+                case P_EXP_INDEX:
+                case P_EXP_FIELD:
                     if (!checkType(p1, p2)) 
                         pError(TYPE_MISMATCH_ASSIGN, t->line, "Type mismatched for assignment.");
                     else
-                        returnType = copyType(p1);
-                } 
-                else
+                        returnType = p1;
+                    break;
+                default:
                     pError(LEFT_VAR_ASSIGN, t->line, "The left-hand side of an assignment must be "
                            "avariable.");
-
             }
-            // Exp -> Exp AND Exp
-            //      | Exp OR Exp
-            //      | Exp RELOP Exp
-            //      | Exp PLUS Exp
-            //      | Exp MINUS Exp
-            //      | Exp STAR Exp
-            //      | Exp DIV Exp
+
+            return returnType;
+        }
+
+        // Exp -> Exp AND Exp
+        //      | Exp OR Exp
+        //      | Exp RELOP Exp
+        //      | Exp PLUS Exp
+        //      | Exp MINUS Exp
+        //      | Exp STAR Exp
+        //      | Exp DIV Exp
+        case P_EXP_AND:
+        case P_EXP_OR:
+        case P_EXP_RELOP:
+        case P_EXP_PLUS:
+        case P_EXP_MINUS:
+        case P_EXP_STAR:
+        case P_EXP_DIV: {
+            pType p1 = Exp(t);
+            pType p2 = Exp(t->sibling->sibling);
+            pType returnType = NULL;
+
+            if (p1 && p2 && (p1->kind == ARRAY || p2->kind == ARRAY))
+                pError(TYPE_MISMATCH_OP, t->line, "Type mismatched for operands.");
+            else if (!checkType(p1, p2)) 
+                pError(TYPE_MISMATCH_OP, t->line, "Type mismatched for operands.");
             else {
-                if (p1 && p2 && (p1->kind == ARRAY || p2->kind == ARRAY))
-                    pError(TYPE_MISMATCH_OP, t->line, "Type mismatched for operands.");
-                else if (!checkType(p1, p2)) 
-                    pError(TYPE_MISMATCH_OP, t->line, "Type mismatched for operands.");
-                else {
-                    if (p1 && p2)
-                        returnType = copyType(p1);
-                }
+                if (p1 && p2)
+                    returnType = p1;
             }
 
-            if (p1) 
-                deleteType(p1);
-            if (p2) 
-                deleteType(p2);
             return returnType;
         }
-        else {
-            // Exp -> Exp LB Exp RB
-            if (!strcmp(t->sibling->name, "LB")) {
-                pType p1 = Exp(t);
-                pType p2 = Exp(t->sibling->sibling);
-                pType returnType = NULL;
-
-                if (!p1) { } 
-                else if (p1 && p1->kind != ARRAY) {
-                    char msg[100] = {0};
-                    sprintf(msg, "\"%s\" is not an array.", t->child->val);
-                    pError(NOT_A_ARRAY, t->line, msg);
-                } 
-                else if (!p2 || p2->kind != BASIC || p2->u.basic != INT_TYPE) {
+
+        // Exp -> Exp LB Exp RB
+        case P_EXP_INDEX: {
+            pType p1 = Exp(t);
+            pType p2 = Exp(t->sibling->sibling);
+            pType returnType = NULL;
+
+            if (!p1) { } 
+            else if (p1 && p1->kind != ARRAY) {
+                char msg[100] = {0};
+                sprintf(msg, "\"%s\" is not an array.", t->child->val);
+                pError(NOT_A_ARRAY, t->line, msg);
+            } 
+            else if (!p2 || p2->kind != BASIC || p2->u.basic != INT_TYPE) {
+                char msg[100] = {0};
+                sprintf(msg, "\"%s\" is not an integer.", t->sibling->sibling->child->val);
+                pError(NOT_A_INT, t->line, msg);
+            } 
+            else
+                returnType = p1->u.array.elem;
+            return returnType;
+        }
+
+        // Exp -> Exp DOT ID
+        case P_EXP_FIELD: {
+            pType p1 = Exp(t);
+            pType returnType = NULL;
+            if (!p1 || p1->kind != STRUCTURE || !p1->u.structure.structName) {
+                pError(ILLEGAL_USE_DOT, t->line, "Illegal use of \".\".");
+            } 
+            else {
+                pNode ref_id = t->sibling->sibling;
+                pFieldList structfield = findField(p1, ref_id->val);
+                if (structfield == NULL) {
                     char msg[100] = {0};
-                    sprintf(msg, "\"%s\" is not an integer.", t->sibling->sibling->child->val);
-                    pError(NOT_A_INT, t->line, msg);
+                    sprintf(msg, "Non-existent field \"%s\".", ref_id->val);
+                    pError(NONEXISTFIELD, t->line, msg);
                 } 
                 else
-                    returnType = copyType(p1->u.array.elem);
-                if (p1) 
-                    deleteType(p1);
-                if (p2) 
-                    deleteType(p2);
-                return returnType;
-            }
-            // Exp -> Exp DOT ID
-            else {
-                pType p1 = Exp(t);
-                pType returnType = NULL;
-                if (!p1 || p1->kind != STRUCTURE || !p1->u.structure.structName) {
-                    pError(ILLEGAL_USE_DOT, t->line, "Illegal use of \".\".");
-                    if (p1) 
-                        deleteType(p1);
-                } 
-                else {
-                    pNode ref_id = t->sibling->sibling;
-                    pFieldList structfield = p1->u.structure.field;
-                    while (structfield != NULL) {
-                        if (!strcmp(structfield->name, ref_id->val))
-                            break;
-                        structfield = structfield->tail;
-                    }
-                    if (structfield == NULL) {
-                        char msg[100] = {0};
-                        sprintf(msg, "Non-existent field \"%s\".", ref_id->val);
-                        pError(NONEXISTFIELD, t->line, msg);
-                    } 
-                    else
-                        returnType = copyType(structfield->type);
-                }
-                if (p1) 
-                    deleteType(p1);
-                return returnType;
+                    returnType = structfield->type;
             }
+            return returnType;
         }
-    }
-    // Exp -> MINUS Exp
-    //      | NOT Exp
-    else if (!strcmp(t->name, "MINUS") || !strcmp(t->name, "NOT")) {
-        pType p1 = Exp(t->sibling);
-        pType returnType = NULL;
-        if (!p1 || p1->kind != BASIC)
-            printf("Error type %d at Line %d: %s.\n", 7, t->line, "TYPE_MISMATCH_OP");
-        else
-            returnType = copyType(p1);
-        if (p1) 
-            deleteType(p1);
-        return returnType;
-    } 
-    else if (!strcmp(t->name, "LP"))
-        return Exp(t->sibling);
-    // Exp -> ID LP Args RP
-    //		| ID LP RP
-    else if (!strcmp(t->name, "ID") && t->sibling) {
-        pItem funcInfo = searchTableItem(table, t->val);
-
-        if (funcInfo == NULL) {
-            char msg[100] = {0};
-            sprintf(msg, "Undefined function \"%s\".", t->val);
-            pError(UNDEF_FUNC, node->line, msg);
-            return NULL;
-        } 
-        else if (funcInfo->field->type->kind != FUNCTION) {
-            char msg[100] = {0};
-            sprintf(msg, "\"%s\" is not a function.", t->val);
-            pError(NOT_A_FUNC, node->line, msg);
-            return NULL;
+
+        // Exp -> MINUS Exp
+        //      | NOT Exp
+        case P_EXP_NEG:
+        case P_EXP_NOT: {
+            pType p1 = Exp(t->sibling);
+            pType returnType = NULL;
+            if (!p1 || p1->kind != BASIC) {
+                semError = 1;
+                printf("Error type %d at Line %d: %s.\n", 7, t->line, "TYPE_MISMATCH_OP");
+            }
+            else
+                returnType = p1;
+            return returnType;
         }
+
+        // Exp -> LP Exp RP
+        case P_EXP_PAREN:
+            return Exp(t->sibling);
+
         // Exp -> ID LP Args RP
-        else if (!strcmp(t->sibling->sibling->name, "Args")) {
-            Args(t->sibling->sibling, funcInfo);
-            return copyType(funcInfo->field->type->u.function.returnType);
-        }
-        // Exp -> ID LP RP
-        else {
-            if (funcInfo->field->type->u.function.argc != 0) {
+        //      | ID LP RP
+        case P_EXP_CALL_ARGS:
+        case P_EXP_CALL: {
+            pItem funcInfo = searchTableItem(table, t->val);
+
+            if (funcInfo == NULL) {
+                char msg[100] = {0};
+                sprintf(msg, "Undefined function \"%s\".", t->val);
+                pError(UNDEF_FUNC, node->line, msg);
+                return NULL;
+            } 
+            else if (funcInfo->field->type->kind != FUNCTION) {
                 char msg[100] = {0};
-                sprintf(msg, "too few arguments to function \"%s\", except %d args.", funcInfo->field->name, funcInfo->field->type->u.function.argc);
-                pError(FUNC_AGRC_MISMATCH, node->line, msg);
+                sprintf(msg, "\"%s\" is not a function.", t->val);
+                pError(NOT_A_FUNC, node->line, msg);
+                return NULL;
+            }
+            t->item = funcInfo;
+            // Exp -> ID LP Args RP
+            if (node->prod == P_EXP_CALL_ARGS) {
+                Args(t->sibling->sibling, funcInfo);
+                return funcInfo->field->type->u.function.returnType;
+            }
+            // Exp -> ID LP RP
+            else {
+                if (funcInfo->field->type->u.function.argc != 0) {
+                    char msg[100] = {0};
+                    sprintf(msg, "too few arguments to function \"%s\", except %d args.", funcInfo->field->name, funcInfo->field->type->u.function.argc);
+                    pError(FUNC_AGRC_MISMATCH, node->line, msg);
+                }
+                return funcInfo->field->type->u.function.returnType;
             }
-            return copyType(funcInfo->field->type->u.function.returnType);
         }
-    }
-    // Exp -> ID
-    else if (!strcmp(t->name, "ID")) {
-        pItem tp = searchTableItem(table, t->val);
-        if (tp == NULL || isStructDef(tp)) {
-            char msg[100] = {0};
-            sprintf(msg, "Undefined variable \"%s\".", t->val);
-            pError(UNDEF_VAR, t->line, msg);
-            return NULL;
-        } 
-        else 
-            return copyType(tp->field->type);
-    } 
-    else {
+
+        // Exp -> ID
+        case P_EXP_ID: {
+            pItem tp = searchTableItem(table, t->val);
+            if (tp == NULL || isStructDef(tp)) {
+                char msg[100] = {0};
+                sprintf(msg, "Undefined variable \"%s\".", t->val);
+                pError(UNDEF_VAR, t->line, msg);
+                return NULL;
+            } 
+            t->item = tp;
+            return tp->field->type;
+        }
+
         // Exp -> FLOAT
-        if (!strcmp(t->name, "FLOAT"))
-            return newType(BASIC, 1, FLOAT_TYPE);
+        case P_EXP_FLOAT:
+            return getBasicType(FLOAT_TYPE);
+
         // Exp -> INT
-        else
-            return newType(BASIC, 1, INT_TYPE);
+        case P_EXP_INT:
+            return getBasicType(INT_TYPE);
+
+        default:
+            assert(0);
+            return NULL;
     }
 }
 
@@ -996,12 +1132,8 @@ void Args(pNode node, pItem funcInfo) {
             char msg[100] = {0};
             sprintf(msg, "Function \"%s\" is not applicable for arguments.", funcInfo->field->name);
             pError(FUNC_AGRC_MISMATCH, node->line, msg);
-            if (realType) 
-                 deleteType(realType);
             return;
         }
-        if (realType) 
-            deleteType(realType);
 
         arg = arg->tail;
         if (temp->child->sibling)
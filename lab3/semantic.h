@@ -1,8 +1,10 @@
 #ifndef SEMANTIC_H
 #define SEMENTIC_H
 
-#define HASH_TABLE_SIZE 0x3fff
-#define STACK_DEEP
+#define HASH_TABLE_INIT_SIZE 0x40
+#define HASH_TABLE_MAX_LOAD 0.75
+#define STACK_INIT_DEPTH 0x10
+#define FIELD_HASH_MIN 8       // structs with this many fields find them through a hash
 
 #include "node.h"
 
@@ -34,6 +36,7 @@ typedef enum errorType {
 } ErrorType;
 
 typedef struct type* pType;
+typedef struct typeTable* pTypeTable;
 typedef struct fieldList* pFieldList;
 typedef struct tableItem* pItem;
 typedef struct hashTable* pHash;
@@ -48,11 +51,14 @@ typedef struct type {
         struct {
             pType elem;
             int size;
+            pType sibling;   // next interned array type with the same elem
         } array;
         
         struct {
             char* structName;
             pFieldList field;
+            pFieldList* fieldHash;  // open addressing by field name, NULL for narrow structs
+            unsigned fieldMask;
         } structure;
 
         struct {
@@ -61,16 +67,21 @@ typedef struct type {
             pType returnType;  
         } function;
     } u;
+    int size;       // bytes, a struct's is set by layoutStruct once its fields are known
+    pType arrayOf;  // interned array types whose elem is this type
+    pType next;     // next type owned by the type table
 } Type;
 
 typedef struct fieldList {
     char* name;
     pType type;
     boolean isArg;
+    int offset;     // bytes from the start of the struct, for struct fields
     pFieldList tail;
 } FieldList;
 
 typedef struct tableItem {
+    unsigned hashCode;
     int symbolDepth;
     pFieldList field;
     pItem nextSymbol;
@@ -79,13 +90,22 @@ typedef struct tableItem {
 
 typedef struct hashTable {
     pItem* hashArray;
+    unsigned size;      // number of buckets, always a power of 2
+    unsigned count;     // number of items
 } HashTable;
 
 typedef struct stack {
     pItem* stackArray;
     int curStackDepth;
+    int capacity;
 } Stack;
 
+// owns every Type, so types can be shared by pointer and compared by identity
+typedef struct typeTable {
+    pType basicType[2];     // indexed by BasicType
+    pType head;
+} TypeTable;
+
 typedef struct table {
     pHash hash;
     pStack stack;
@@ -93,13 +113,23 @@ typedef struct table {
 } Table;
 
 extern pTable table;
+extern pTypeTable typeTable;
+// set once pError has reported anything
+extern int semError;
 
 // Type functions
 pType newType(Kind kind, int argc, ...);
-pType copyType(pType src);
 void deleteType(pType type);
 boolean checkType(pType type1, pType type2);
 
+// TypeTable functions
+pTypeTable newTypeTable();
+void deleteTypeTable(pTypeTable typeTable);
+pType getBasicType(BasicType basic);
+pType getArrayType(pType elem, int size);
+void layoutStruct(pType type);
+pFieldList findField(pType type, char* name);
+
 // FieldList functions
 pFieldList newFieldList(char* newName, pType newType);
 pFieldList copyFieldList(pFieldList src);
@@ -110,12 +140,15 @@ void setFieldListName(pFieldList p, char* newName);
 pItem newItem(int symbolDepth, pFieldList pfield);
 void deleteItem(pItem item);
 boolean isStructDef(pItem src);
+void discardItem(pNode varDec, pItem item);
 
 // Hash functions
-pHash newHash();
+pHash newHash(unsigned size);
 void deleteHash(pHash hash);
-pItem getHashHead(pHash hash, int index);
-void setHashHead(pHash hash, int index, pItem newVal);
+void resizeHash(pHash hash, unsigned newSize);
+unsigned getHashIndex(pHash hash, unsigned hashCode);
+pItem getHashHead(pHash hash, unsigned index);
+void setHashHead(pHash hash, unsigned index, pItem newVal);
 
 // Stack functions
 pStack newStack();
@@ -133,6 +166,7 @@ boolean checkTableItemConflict(pTable table, pItem item);
 void addTableItem(pTable table, pItem item);
 void deleteTableItem(pTable table, pItem item);
 void clearCurDepthStackList(pTable table);
+void clearStackAbove(pTable table, int depth);
 
 // Generate symbol table functions
 void ExtDef(pNode node);
@@ -150,6 +184,7 @@ void DefList(pNode node, pItem structInfo);
 void Def(pNode node, pItem structInfo);
 void DecList(pNode node, pType specifier, pItem structInfo);
 void Dec(pNode node, pType specifier, pItem structInfo);
+// the type is borrowed from typeTable or the symbol table, checking an expression allocates nothing
 pType Exp(pNode node);
 void Args(pNode node, pItem funcInfo);
 
@@ -163,17 +198,16 @@ static inline char* newString(char* src) {
     return p;
 }
 
+// FxHash-style rotate-xor-multiply, with a final fold so the low bits used as the bucket index are well mixed
 static inline unsigned int getHashCode(char* name) {
-    unsigned int val = 0, i;
-    for (; *name; ++name) {
-        val = (val << 2) + *name;
-        if (i = val & ~HASH_TABLE_SIZE)
-            val = (val ^ (i >> 12)) & HASH_TABLE_SIZE;
-    }
-    return val;
+    unsigned int val = 0;
+    for (; *name; ++name)
+        val = (((val << 5) | (val >> 27)) ^ (unsigned char)*name) * 0x9e3779b9u;
+    return val ^ (val >> 16);
 }
 
 static inline void pError(ErrorType type, int line, char* msg) {
+    semError = 1;
     printf("Error type %d at Line %d: %s\n", type, line, msg);
 }
 
@@ -1,8 +1,8 @@
-/* A Bison parser, made by GNU Bison 3.5.1.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2020 Free Software Foundation,
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
    Inc.
 
    This program is free software: you can redistribute it and/or modify
@@ -16,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -34,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -41,14 +45,11 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Undocumented macros, especially those whose name start with YY_,
-   are private implementation details.  Do not rely on them.  */
-
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "3.5.1"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
@@ -72,8 +73,11 @@
 #include "lex.yy.c"
 extern int synError;
 pNode root;
+pArena nodeArena;
+void (*extDefHandler)(pNode extDef);
+pNode addExtDef(pNode list, pNode extDef, int line);
 
-#line 77 "syntax.tab.c"
+#line 81 "syntax.tab.c"
 
 # ifndef YY_CAST
 #  ifdef __cplusplus
@@ -96,98 +100,67 @@ pNode root;
 #  endif
 # endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 1
-#endif
-
-/* Use api.header.include to #include this header
-   instead of duplicating it here.  */
-#ifndef YY_YY_SYNTAX_TAB_H_INCLUDED
-# define YY_YY_SYNTAX_TAB_H_INCLUDED
-/* Debug traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
-#if YYDEBUG
-extern int yydebug;
-#endif
-
-/* Token type.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-  enum yytokentype
-  {
-    INT = 258,
-    FLOAT = 259,
-    ID = 260,
-    SEMI = 261,
-    COMMA = 262,
-    ASSIGNOP = 263,
-    RELOP = 264,
-    PLUS = 265,
-    MINUS = 266,
-    STAR = 267,
-    DIV = 268,
-    AND = 269,
-    OR = 270,
-    NOT = 271,
-    DOT = 272,
-    TYPE = 273,
-    LP = 274,
-    RP = 275,
-    LB = 276,
-    RB = 277,
-    LC = 278,
-    RC = 279,
-    STRUCT = 280,
-    RETURN = 281,
-    IF = 282,
-    ELSE = 283,
-    WHILE = 284,
-    LOWER_THAN_ELSE = 285
-  };
-#endif
-
-/* Value type.  */
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-union YYSTYPE
+#include "syntax.tab.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
 {
-#line 12 "syntax.y"
-
-    pNode node; 
-
-#line 164 "syntax.tab.c"
-
-};
-typedef union YYSTYPE YYSTYPE;
-# define YYSTYPE_IS_TRIVIAL 1
-# define YYSTYPE_IS_DECLARED 1
-#endif
-
-/* Location type.  */
-#if ! defined YYLTYPE && ! defined YYLTYPE_IS_DECLARED
-typedef struct YYLTYPE YYLTYPE;
-struct YYLTYPE
-{
-  int first_line;
-  int first_column;
-  int last_line;
-  int last_column;
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_INT = 3,                        /* INT  */
+  YYSYMBOL_FLOAT = 4,                      /* FLOAT  */
+  YYSYMBOL_ID = 5,                         /* ID  */
+  YYSYMBOL_SEMI = 6,                       /* SEMI  */
+  YYSYMBOL_COMMA = 7,                      /* COMMA  */
+  YYSYMBOL_ASSIGNOP = 8,                   /* ASSIGNOP  */
+  YYSYMBOL_RELOP = 9,                      /* RELOP  */
+  YYSYMBOL_PLUS = 10,                      /* PLUS  */
+  YYSYMBOL_MINUS = 11,                     /* MINUS  */
+  YYSYMBOL_STAR = 12,                      /* STAR  */
+  YYSYMBOL_DIV = 13,                       /* DIV  */
+  YYSYMBOL_AND = 14,                       /* AND  */
+  YYSYMBOL_OR = 15,                        /* OR  */
+  YYSYMBOL_NOT = 16,                       /* NOT  */
+  YYSYMBOL_DOT = 17,                       /* DOT  */
+  YYSYMBOL_TYPE = 18,                      /* TYPE  */
+  YYSYMBOL_LP = 19,                        /* LP  */
+  YYSYMBOL_RP = 20,                        /* RP  */
+  YYSYMBOL_LB = 21,                        /* LB  */
+  YYSYMBOL_RB = 22,                        /* RB  */
+  YYSYMBOL_LC = 23,                        /* LC  */
+  YYSYMBOL_RC = 24,                        /* RC  */
+  YYSYMBOL_STRUCT = 25,                    /* STRUCT  */
+  YYSYMBOL_RETURN = 26,                    /* RETURN  */
+  YYSYMBOL_IF = 27,                        /* IF  */
+  YYSYMBOL_ELSE = 28,                      /* ELSE  */
+  YYSYMBOL_WHILE = 29,                     /* WHILE  */
+  YYSYMBOL_LOWER_THAN_ELSE = 30,           /* LOWER_THAN_ELSE  */
+  YYSYMBOL_YYACCEPT = 31,                  /* $accept  */
+  YYSYMBOL_Program = 32,                   /* Program  */
+  YYSYMBOL_ExtDefList = 33,                /* ExtDefList  */
+  YYSYMBOL_ExtDef = 34,                    /* ExtDef  */
+  YYSYMBOL_ExtDecList = 35,                /* ExtDecList  */
+  YYSYMBOL_Specifier = 36,                 /* Specifier  */
+  YYSYMBOL_StructSpecifier = 37,           /* StructSpecifier  */
+  YYSYMBOL_OptTag = 38,                    /* OptTag  */
+  YYSYMBOL_Tag = 39,                       /* Tag  */
+  YYSYMBOL_VarDec = 40,                    /* VarDec  */
+  YYSYMBOL_FunDec = 41,                    /* FunDec  */
+  YYSYMBOL_VarList = 42,                   /* VarList  */
+  YYSYMBOL_ParamDec = 43,                  /* ParamDec  */
+  YYSYMBOL_CompSt = 44,                    /* CompSt  */
+  YYSYMBOL_StmtList = 45,                  /* StmtList  */
+  YYSYMBOL_Stmt = 46,                      /* Stmt  */
+  YYSYMBOL_DefList = 47,                   /* DefList  */
+  YYSYMBOL_Def = 48,                       /* Def  */
+  YYSYMBOL_DecList = 49,                   /* DecList  */
+  YYSYMBOL_Dec = 50,                       /* Dec  */
+  YYSYMBOL_Exp = 51,                       /* Exp  */
+  YYSYMBOL_Args = 52                       /* Args  */
 };
-# define YYLTYPE_IS_DECLARED 1
-# define YYLTYPE_IS_TRIVIAL 1
-#endif
-
-
-extern YYSTYPE yylval;
-extern YYLTYPE yylloc;
-int yyparse (void);
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
-#endif /* !YY_YY_SYNTAX_TAB_H_INCLUDED  */
 
 
 
@@ -228,6 +201,18 @@ typedef int_least16_t yytype_int16;
 typedef short yytype_int16;
 #endif
 
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
 #if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
 typedef __UINT_LEAST8_TYPE__ yytype_uint8;
 #elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
@@ -287,6 +272,7 @@ typedef int yytype_uint16;
 
 #define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
 
+
 /* Stored state numbers (used for stacks). */
 typedef yytype_int8 yy_state_t;
 
@@ -305,6 +291,7 @@ typedef int yy_state_fast_t;
 # endif
 #endif
 
+
 #ifndef YY_ATTRIBUTE_PURE
 # if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
 #  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
@@ -323,17 +310,23 @@ typedef int yy_state_fast_t;
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-#if defined __GNUC__ && ! defined __ICC && 407 <= __GNUC__ * 100 + __GNUC_MINOR__
 /* Suppress an incorrect diagnostic about yylval being uninitialized.  */
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                            \
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
     _Pragma ("GCC diagnostic push")                                     \
     _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
     _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
 # define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
     _Pragma ("GCC diagnostic pop")
 #else
@@ -362,7 +355,7 @@ typedef int yy_state_fast_t;
 
 #define YY_ASSERT(E) ((void) (0 && (E)))
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#if 1
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -427,8 +420,7 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* 1 */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
@@ -494,7 +486,7 @@ union yyalloc
 #endif /* !YYCOPY_NEEDED */
 
 /* YYFINAL -- State number of the termination state.  */
-#define YYFINAL  13
+#define YYFINAL  3
 /* YYLAST -- Last index in YYTABLE.  */
 #define YYLAST   254
 
@@ -505,16 +497,18 @@ union yyalloc
 /* YYNRULES -- Number of rules.  */
 #define YYNRULES  64
 /* YYNSTATES -- Number of states.  */
-#define YYNSTATES  121
+#define YYNSTATES  120
 
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   285
 
 
 /* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
    as returned by yylex, with out-of-bounds checking.  */
-#define YYTRANSLATE(YYX)                                                \
-  (0 <= (YYX) && (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
 /* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
    as returned by yylex.  */
@@ -552,47 +546,49 @@ static const yytype_int8 yytranslate[] =
 };
 
 #if YYDEBUG
-  /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_uint8 yyrline[] =
 {
-       0,    51,    51,    53,    54,    56,    57,    58,    59,    61,
-      62,    66,    67,    69,    70,    72,    73,    75,    79,    80,
-      81,    83,    84,    85,    87,    88,    90,    94,    95,    97,
-      98,   100,   101,   102,   103,   104,   105,   106,   110,   111,
-     113,   115,   116,   118,   119,   123,   124,   125,   126,   127,
-     128,   129,   130,   131,   132,   133,   134,   135,   136,   137,
-     138,   139,   140,   142,   143
+       0,    54,    54,    56,    57,    59,    60,    61,    62,    64,
+      65,    69,    70,    72,    73,    75,    76,    78,    82,    83,
+      84,    86,    87,    88,    90,    91,    93,    97,    98,   100,
+     101,   103,   104,   105,   106,   107,   108,   109,   113,   114,
+     116,   118,   119,   121,   122,   126,   127,   128,   129,   130,
+     131,   132,   133,   134,   135,   136,   137,   138,   139,   140,
+     141,   142,   143,   145,   146
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || 1
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if 1
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "INT", "FLOAT", "ID", "SEMI", "COMMA",
-  "ASSIGNOP", "RELOP", "PLUS", "MINUS", "STAR", "DIV", "AND", "OR", "NOT",
-  "DOT", "TYPE", "LP", "RP", "LB", "RB", "LC", "RC", "STRUCT", "RETURN",
-  "IF", "ELSE", "WHILE", "LOWER_THAN_ELSE", "$accept", "Program",
-  "ExtDefList", "ExtDef", "ExtDecList", "Specifier", "StructSpecifier",
-  "OptTag", "Tag", "VarDec", "FunDec", "VarList", "ParamDec", "CompSt",
-  "StmtList", "Stmt", "DefList", "Def", "DecList", "Dec", "Exp", "Args", YY_NULLPTR
+  "\"end of file\"", "error", "\"invalid token\"", "INT", "FLOAT", "ID",
+  "SEMI", "COMMA", "ASSIGNOP", "RELOP", "PLUS", "MINUS", "STAR", "DIV",
+  "AND", "OR", "NOT", "DOT", "TYPE", "LP", "RP", "LB", "RB", "LC", "RC",
+  "STRUCT", "RETURN", "IF", "ELSE", "WHILE", "LOWER_THAN_ELSE", "$accept",
+  "Program", "ExtDefList", "ExtDef", "ExtDecList", "Specifier",
+  "StructSpecifier", "OptTag", "Tag", "VarDec", "FunDec", "VarList",
+  "ParamDec", "CompSt", "StmtList", "Stmt", "DefList", "Def", "DecList",
+  "Dec", "Exp", "Args", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[NUM] -- (External) token number corresponding to the
-   (internal) symbol number NUM (which must be that of a token).  */
-static const yytype_int16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-#define YYPACT_NINF (-102)
+#define YYPACT_NINF (-61)
 
 #define yypact_value_is_default(Yyn) \
   ((Yyn) == YYPACT_NINF)
@@ -602,144 +598,141 @@ static const yytype_int16 yytoknum[] =
 #define yytable_value_is_error(Yyn) \
   0
 
-  /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-     STATE-NUM.  */
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
 static const yytype_int16 yypact[] =
 {
-      22,     1,  -102,    33,    50,  -102,    22,   101,  -102,  -102,
-      29,    32,  -102,  -102,  -102,    17,    39,  -102,    54,    -2,
-      13,    -9,  -102,  -102,   229,  -102,    60,    76,    58,    -9,
-    -102,    60,    68,    -9,  -102,    60,    71,   102,    79,  -102,
-    -102,    86,  -102,    40,    25,   105,   115,  -102,  -102,   103,
-    -102,    -9,  -102,     0,  -102,  -102,   119,    94,    94,    94,
-      94,   132,   134,  -102,   130,    40,   106,    94,  -102,    60,
-    -102,  -102,    84,    36,    63,   164,   120,    94,    94,  -102,
-    -102,  -102,    94,    94,    94,    94,    94,    94,    94,    94,
-     150,    94,   206,  -102,  -102,   135,   145,  -102,  -102,   178,
-     192,   206,   231,    36,    36,    63,    63,    64,   219,  -102,
-     149,    94,  -102,    67,    67,  -102,  -102,    97,  -102,    67,
-    -102
+     -61,    16,    22,   -61,    11,   -61,    33,   -61,    56,   -61,
+     -61,    25,    32,   -61,    17,    46,   -61,    73,    -2,    12,
+      -7,   -61,   -61,   -11,   -61,    45,    79,    68,    -7,   -61,
+      45,    77,    -7,   -61,    45,    71,   100,    86,   -61,   -61,
+      87,   -61,    40,    28,   105,   115,   -61,   -61,   103,   -61,
+      -7,   -61,     0,   -61,   -61,   117,    94,    94,    94,    94,
+     119,   121,   -61,   101,    40,   106,    94,   -61,    45,   -61,
+     -61,    84,   233,    63,   164,   120,    94,    94,   -61,   -61,
+     -61,    94,    94,    94,    94,    94,    94,    94,    94,   134,
+      94,   206,   -61,   -61,   135,   131,   -61,   -61,   178,   192,
+     206,   231,   233,   233,    63,    63,    64,   219,   -61,   149,
+      94,   -61,    67,    67,   -61,   -61,   125,   -61,    67,   -61
 };
 
-  /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
-     Performed when YYTABLE does not specify something else to do.  Zero
-     means the default is an error.  */
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
 static const yytype_int8 yydefact[] =
 {
-       0,     0,    11,    16,     0,     2,     0,     0,    12,     8,
-      17,     0,    14,     1,     3,     0,    18,     6,     0,     9,
-       0,    39,    23,    20,     0,     5,     0,     0,     0,    39,
-       7,     0,     0,    39,    22,     0,     0,    25,     0,    18,
-      10,     0,    28,     0,    43,     0,    41,    13,    38,    26,
-      21,     0,    19,     0,    61,    62,    60,     0,     0,     0,
-       0,     0,     0,    32,     0,     0,     0,     0,    40,     0,
-      24,    37,     0,    54,    55,     0,     0,     0,     0,    27,
-      29,    31,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,    44,    42,    57,    64,     0,    53,    33,     0,
-       0,    45,    48,    49,    50,    51,    52,    46,    47,    59,
-       0,     0,    56,     0,     0,    58,    63,    34,    36,     0,
-      35
+       4,     0,     0,     1,     0,    11,    16,     3,     0,    12,
+       8,    17,     0,    14,     0,    18,     6,     0,     9,     0,
+      39,    23,    20,     0,     5,     0,     0,     0,    39,     7,
+       0,     0,    39,    22,     0,     0,    25,     0,    18,    10,
+       0,    28,     0,    43,     0,    41,    13,    38,    26,    21,
+       0,    19,     0,    61,    62,    60,     0,     0,     0,     0,
+       0,     0,    32,     0,     0,     0,     0,    40,     0,    24,
+      37,     0,    54,    55,     0,     0,     0,     0,    27,    29,
+      31,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,    44,    42,    57,    64,     0,    53,    33,     0,     0,
+      45,    48,    49,    50,    51,    52,    46,    47,    59,     0,
+       0,    56,     0,     0,    58,    63,    34,    36,     0,    35
 };
 
-  /* YYPGOTO[NTERM-NUM].  */
+/* YYPGOTO[NTERM-NUM].  */
 static const yytype_int16 yypgoto[] =
 {
-    -102,  -102,   133,  -102,   141,    11,  -102,  -102,  -102,   -27,
-    -102,   117,  -102,   160,   104,  -101,   107,  -102,   113,  -102,
-     -57,    72
+     -61,   -61,   -61,   -61,   129,    10,   -61,   -61,   -61,   -26,
+     -61,   118,   -61,   136,   116,   -60,    74,   -61,    97,   -61,
+     -56,    57
 };
 
-  /* YYDEFGOTO[NTERM-NUM].  */
+/* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_int8 yydefgoto[] =
 {
-      -1,     4,     5,     6,    18,    31,     8,    11,    12,    19,
-      20,    36,    37,    63,    64,    65,    32,    33,    45,    46,
-      66,    96
+       0,     1,     2,     7,    17,    30,     9,    12,    13,    18,
+      19,    35,    36,    62,    63,    64,    31,    32,    44,    45,
+      65,    95
 };
 
-  /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
-     positive, shift that token.  If negative, reduce the rule whose
-     number is the opposite.  If YYTABLE_NINF, syntax error.  */
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_int8 yytable[] =
 {
-      73,    74,    75,    76,    44,    26,    71,     9,    49,     2,
-      92,     7,   117,   118,    28,    95,     3,     7,   120,    27,
-      99,   100,    -4,     1,    42,   101,   102,   103,   104,   105,
-     106,   107,   108,    67,   110,    35,    29,    22,    10,    23,
-       2,    53,    44,    54,    55,    56,    27,     3,    86,    87,
-      13,    57,   -15,    90,    95,    21,    58,    91,    24,    59,
-      25,    38,    35,    29,   -30,    39,    60,    61,    53,    62,
-      54,    55,    56,    83,    84,    85,    86,    87,    57,    41,
-      90,    90,    42,    58,    91,    91,    59,    54,    55,    56,
-      29,    50,    47,    60,    61,    57,    62,    54,    55,    56,
-      58,    23,    15,    59,    94,    57,    16,    17,    52,    51,
-      58,    68,    81,    59,    82,    83,    84,    85,    86,    87,
-      88,    89,    69,    90,    27,   119,    98,    91,    82,    83,
-      84,    85,    86,    87,    88,    89,    43,    90,    72,    14,
-      48,    91,   111,    82,    83,    84,    85,    86,    87,    88,
-      89,    77,    90,    78,    79,   109,    91,    82,    83,    84,
-      85,    86,    87,    88,    89,   112,    90,    40,    70,    80,
-      91,   115,    82,    83,    84,    85,    86,    87,    88,    89,
-      30,    90,    93,   116,    97,    91,    82,    83,    84,    85,
-      86,    87,    88,    89,     0,    90,     0,     0,   113,    91,
-      82,    83,    84,    85,    86,    87,    88,    89,     0,    90,
-       0,     0,   114,    91,    82,    83,    84,    85,    86,    87,
-      88,    89,     0,    90,     0,     0,     0,    91,    83,    84,
-      85,    86,    87,    88,     0,     0,    90,     0,     0,     0,
-      91,    84,    85,    86,    87,     0,     0,     2,    90,    34,
-       0,     0,    91,     0,     3
+      72,    73,    74,    75,    43,    25,    70,     5,    48,    33,
+      91,     5,     8,    27,     6,    94,     3,    10,     6,    26,
+      98,    99,    -2,     4,    41,   100,   101,   102,   103,   104,
+     105,   106,   107,    34,   109,    28,    66,    21,    11,    22,
+       5,    52,    43,    53,    54,    55,    37,     6,   -15,    26,
+      38,    56,   116,   117,    94,    20,    57,    14,   119,    58,
+      34,    15,    16,    28,   -30,    23,    59,    60,    52,    61,
+      53,    54,    55,    82,    83,    84,    85,    86,    56,    24,
+      89,    89,    40,    57,    90,    90,    58,    53,    54,    55,
+      28,    49,    41,    59,    60,    56,    61,    53,    54,    55,
+      57,    46,    42,    58,    93,    56,    47,    50,    22,    51,
+      57,    67,    80,    58,    81,    82,    83,    84,    85,    86,
+      87,    88,    68,    89,    26,    78,    97,    90,    81,    82,
+      83,    84,    85,    86,    87,    88,    71,    89,    76,   108,
+      77,    90,   110,    81,    82,    83,    84,    85,    86,    87,
+      88,   111,    89,   118,    39,    29,    90,    81,    82,    83,
+      84,    85,    86,    87,    88,    92,    89,   115,    69,     0,
+      90,   114,    81,    82,    83,    84,    85,    86,    87,    88,
+      79,    89,     0,     0,    96,    90,    81,    82,    83,    84,
+      85,    86,    87,    88,     0,    89,     0,     0,   112,    90,
+      81,    82,    83,    84,    85,    86,    87,    88,     0,    89,
+       0,     0,   113,    90,    81,    82,    83,    84,    85,    86,
+      87,    88,     0,    89,     0,     0,     0,    90,    82,    83,
+      84,    85,    86,    87,     0,     0,    89,     0,     0,     0,
+      90,    83,    84,    85,    86,    85,    86,     0,    89,     0,
+      89,     0,    90,     0,    90
 };
 
 static const yytype_int8 yycheck[] =
 {
-      57,    58,    59,    60,    31,     7,     6,     6,    35,    18,
-      67,     0,   113,   114,     1,    72,    25,     6,   119,    21,
-      77,    78,     0,     1,    24,    82,    83,    84,    85,    86,
-      87,    88,    89,     8,    91,    24,    23,    20,     5,    22,
-      18,     1,    69,     3,     4,     5,    21,    25,    12,    13,
-       0,    11,    23,    17,   111,    23,    16,    21,    19,    19,
-       6,     1,    51,    23,    24,     5,    26,    27,     1,    29,
-       3,     4,     5,     9,    10,    11,    12,    13,    11,     3,
-      17,    17,    24,    16,    21,    21,    19,     3,     4,     5,
+      56,    57,    58,    59,    30,     7,     6,    18,    34,    20,
+      66,    18,     2,     1,    25,    71,     0,     6,    25,    21,
+      76,    77,     0,     1,    24,    81,    82,    83,    84,    85,
+      86,    87,    88,    23,    90,    23,     8,    20,     5,    22,
+      18,     1,    68,     3,     4,     5,     1,    25,    23,    21,
+       5,    11,   112,   113,   110,    23,    16,     1,   118,    19,
+      50,     5,     6,    23,    24,    19,    26,    27,     1,    29,
+       3,     4,     5,     9,    10,    11,    12,    13,    11,     6,
+      17,    17,     3,    16,    21,    21,    19,     3,     4,     5,
       23,    20,    24,    26,    27,    11,    29,     3,     4,     5,
-      16,    22,     1,    19,    20,    11,     5,     6,    22,     7,
+      16,    24,    28,    19,    20,    11,    32,     7,    22,    22,
       16,     6,     6,    19,     8,     9,    10,    11,    12,    13,
-      14,    15,     7,    17,    21,    28,     6,    21,     8,     9,
-      10,    11,    12,    13,    14,    15,    29,    17,    19,     6,
-      33,    21,     7,     8,     9,    10,    11,    12,    13,    14,
-      15,    19,    17,    19,    24,     5,    21,     8,     9,    10,
-      11,    12,    13,    14,    15,    20,    17,    26,    51,    65,
+      14,    15,     7,    17,    21,    24,     6,    21,     8,     9,
+      10,    11,    12,    13,    14,    15,    19,    17,    19,     5,
+      19,    21,     7,     8,     9,    10,    11,    12,    13,    14,
+      15,    20,    17,    28,    25,    19,    21,     8,     9,    10,
+      11,    12,    13,    14,    15,    68,    17,   110,    50,    -1,
       21,    22,     8,     9,    10,    11,    12,    13,    14,    15,
-      20,    17,    69,   111,    20,    21,     8,     9,    10,    11,
+      64,    17,    -1,    -1,    20,    21,     8,     9,    10,    11,
       12,    13,    14,    15,    -1,    17,    -1,    -1,    20,    21,
        8,     9,    10,    11,    12,    13,    14,    15,    -1,    17,
       -1,    -1,    20,    21,     8,     9,    10,    11,    12,    13,
       14,    15,    -1,    17,    -1,    -1,    -1,    21,     9,    10,
       11,    12,    13,    14,    -1,    -1,    17,    -1,    -1,    -1,
-      21,    10,    11,    12,    13,    -1,    -1,    18,    17,    20,
-      -1,    -1,    21,    -1,    25
+      21,    10,    11,    12,    13,    12,    13,    -1,    17,    -1,
+      17,    -1,    21,    -1,    21
 };
 
-  /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-     symbol of state STATE-NUM.  */
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
 static const yytype_int8 yystos[] =
 {
-       0,     1,    18,    25,    32,    33,    34,    36,    37,     6,
-       5,    38,    39,     0,    33,     1,     5,     6,    35,    40,
-      41,    23,    20,    22,    19,     6,     7,    21,     1,    23,
-      44,    36,    47,    48,    20,    36,    42,    43,     1,     5,
-      35,     3,    24,    47,    40,    49,    50,    24,    47,    40,
-      20,     7,    22,     1,     3,     4,     5,    11,    16,    19,
-      26,    27,    29,    44,    45,    46,    51,     8,     6,     7,
-      42,     6,    19,    51,    51,    51,    51,    19,    19,    24,
-      45,     6,     8,     9,    10,    11,    12,    13,    14,    15,
-      17,    21,    51,    49,    20,    51,    52,    20,     6,    51,
-      51,    51,    51,    51,    51,    51,    51,    51,    51,     5,
-      51,     7,    20,    20,    20,    22,    52,    46,    46,    28,
-      46
+       0,    32,    33,     0,     1,    18,    25,    34,    36,    37,
+       6,     5,    38,    39,     1,     5,     6,    35,    40,    41,
+      23,    20,    22,    19,     6,     7,    21,     1,    23,    44,
+      36,    47,    48,    20,    36,    42,    43,     1,     5,    35,
+       3,    24,    47,    40,    49,    50,    24,    47,    40,    20,
+       7,    22,     1,     3,     4,     5,    11,    16,    19,    26,
+      27,    29,    44,    45,    46,    51,     8,     6,     7,    42,
+       6,    19,    51,    51,    51,    51,    19,    19,    24,    45,
+       6,     8,     9,    10,    11,    12,    13,    14,    15,    17,
+      21,    51,    49,    20,    51,    52,    20,     6,    51,    51,
+      51,    51,    51,    51,    51,    51,    51,    51,     5,    51,
+       7,    20,    20,    20,    22,    52,    46,    46,    28,    46
 };
 
-  /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr1[] =
 {
        0,    31,    32,    33,    33,    34,    34,    34,    34,    35,
@@ -751,7 +744,7 @@ static const yytype_int8 yyr1[] =
       51,    51,    51,    52,    52
 };
 
-  /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr2[] =
 {
        0,     2,     1,     2,     0,     3,     2,     3,     2,     1,
@@ -764,14 +757,15 @@ static const yytype_int8 yyr2[] =
 };
 
 
+enum { YYENOMEM = -2 };
+
 #define yyerrok         (yyerrstatus = 0)
 #define yyclearin       (yychar = YYEMPTY)
-#define YYEMPTY         (-2)
-#define YYEOF           0
 
 #define YYACCEPT        goto yyacceptlab
 #define YYABORT         goto yyabortlab
 #define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
 #define YYRECOVERING()  (!!yyerrstatus)
@@ -793,10 +787,9 @@ static const yytype_int8 yyr2[] =
       }                                                           \
   while (0)
 
-/* Error token number */
-#define YYTERROR        1
-#define YYERRCODE       256
-
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
 /* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
    If N is 0, then set CURRENT to the empty location which ends
@@ -840,12 +833,19 @@ do {                                            \
 } while (0)
 
 
-/* YY_LOCATION_PRINT -- Print the location on the stream.
+/* YYLOCATION_PRINT -- Print the location on the stream.
    This macro was not mandated originally: define only if we know
    we won't break user code: when these are the locations we know.  */
 
-#ifndef YY_LOCATION_PRINT
-# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+# ifndef YYLOCATION_PRINT
+
+#  if defined YY_LOCATION_PRINT
+
+   /* Temporary convenience wrapper in case some people defined the
+      undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YYLOCATION_PRINT(File, Loc)  YY_LOCATION_PRINT(File, *(Loc))
+
+#  elif defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
 
 /* Print *YYLOCP on YYO.  Private, do not rely on its existence. */
 
@@ -873,24 +873,32 @@ yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
         res += YYFPRINTF (yyo, "-%d", end_col);
     }
   return res;
- }
+}
 
-#  define YY_LOCATION_PRINT(File, Loc)          \
-  yy_location_print_ (File, &(Loc))
+#   define YYLOCATION_PRINT  yy_location_print_
 
-# else
-#  define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-# endif
-#endif
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT(File, Loc)  YYLOCATION_PRINT(File, &(Loc))
 
+#  else
+
+#   define YYLOCATION_PRINT(File, Loc) ((void) 0)
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT  YYLOCATION_PRINT
 
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)                    \
+#  endif
+# endif /* !defined YYLOCATION_PRINT */
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
 do {                                                                      \
   if (yydebug)                                                            \
     {                                                                     \
       YYFPRINTF (stderr, "%s ", Title);                                   \
       yy_symbol_print (stderr,                                            \
-                  Type, Value, Location); \
+                  Kind, Value, Location); \
       YYFPRINTF (stderr, "\n");                                           \
     }                                                                     \
 } while (0)
@@ -901,19 +909,16 @@ do {                                                                      \
 `-----------------------------------*/
 
 static void
-yy_symbol_value_print (FILE *yyo, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
 {
   FILE *yyoutput = yyo;
-  YYUSE (yyoutput);
-  YYUSE (yylocationp);
+  YY_USE (yyoutput);
+  YY_USE (yylocationp);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyo, yytoknum[yytype], *yyvaluep);
-# endif
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
@@ -923,14 +928,15 @@ yy_symbol_value_print (FILE *yyo, int yytype, YYSTYPE const * const yyvaluep, YY
 `---------------------------*/
 
 static void
-yy_symbol_print (FILE *yyo, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
 {
   YYFPRINTF (yyo, "%s %s (",
-             yytype < YYNTOKENS ? "token" : "nterm", yytname[yytype]);
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  YY_LOCATION_PRINT (yyo, *yylocationp);
+  YYLOCATION_PRINT (yyo, yylocationp);
   YYFPRINTF (yyo, ": ");
-  yy_symbol_value_print (yyo, yytype, yyvaluep, yylocationp);
+  yy_symbol_value_print (yyo, yykind, yyvaluep, yylocationp);
   YYFPRINTF (yyo, ")");
 }
 
@@ -963,7 +969,8 @@ do {                                                            \
 `------------------------------------------------*/
 
 static void
-yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp, int yyrule)
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp,
+                 int yyrule)
 {
   int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
@@ -975,9 +982,9 @@ yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp, int yyrule)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
       yy_symbol_print (stderr,
-                       yystos[+yyssp[yyi + 1 - yynrhs]],
-                       &yyvsp[(yyi + 1) - (yynrhs)]
-                       , &(yylsp[(yyi + 1) - (yynrhs)])                       );
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)],
+                       &(yylsp[(yyi + 1) - (yynrhs)]));
       YYFPRINTF (stderr, "\n");
     }
 }
@@ -992,8 +999,8 @@ do {                                    \
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
@@ -1016,12 +1023,61 @@ int yydebug;
 #endif
 
 
-#if YYERROR_VERBOSE
+/* Context of a parse error.  */
+typedef struct
+{
+  yy_state_t *yyssp;
+  yysymbol_kind_t yytoken;
+  YYLTYPE *yylloc;
+} yypcontext_t;
+
+/* Put in YYARG at most YYARGN of the expected tokens given the
+   current YYCTX, and return the number of tokens stored in YYARG.  If
+   YYARG is null, return the number of expected tokens (guaranteed to
+   be less than YYNTOKENS).  Return YYENOMEM on memory exhaustion.
+   Return 0 if there are more than YYARGN expected tokens, yet fill
+   YYARG up to YYARGN. */
+static int
+yypcontext_expected_tokens (const yypcontext_t *yyctx,
+                            yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  int yyn = yypact[+*yyctx->yyssp];
+  if (!yypact_value_is_default (yyn))
+    {
+      /* Start YYX at -YYN if negative to avoid negative indexes in
+         YYCHECK.  In other words, skip the first -YYN actions for
+         this state because they are default actions.  */
+      int yyxbegin = yyn < 0 ? -yyn : 0;
+      /* Stay within bounds of both yycheck and yytname.  */
+      int yychecklim = YYLAST - yyn + 1;
+      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
+      int yyx;
+      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
+        if (yycheck[yyx + yyn] == yyx && yyx != YYSYMBOL_YYerror
+            && !yytable_value_is_error (yytable[yyx + yyn]))
+          {
+            if (!yyarg)
+              ++yycount;
+            else if (yycount == yyargn)
+              return 0;
+            else
+              yyarg[yycount++] = YY_CAST (yysymbol_kind_t, yyx);
+          }
+    }
+  if (yyarg && yycount == 0 && 0 < yyargn)
+    yyarg[0] = YYSYMBOL_YYEMPTY;
+  return yycount;
+}
 
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
-#  else
+
+
+
+#ifndef yystrlen
+# if defined __GLIBC__ && defined _STRING_H
+#  define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
+# else
 /* Return the length of YYSTR.  */
 static YYPTRDIFF_T
 yystrlen (const char *yystr)
@@ -1031,13 +1087,13 @@ yystrlen (const char *yystr)
     continue;
   return yylen;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
+#ifndef yystpcpy
+# if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
+#  define yystpcpy stpcpy
+# else
 /* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
    YYDEST.  */
 static char *
@@ -1051,10 +1107,10 @@ yystpcpy (char *yydest, const char *yysrc)
 
   return yyd - 1;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yytnamerr
+#ifndef yytnamerr
 /* Copy to YYRES the contents of YYSTR after stripping away unnecessary
    quotes and backslashes, so that it's suitable for yyerror.  The
    heuristic is that double-quoting is unnecessary unless the string
@@ -1069,7 +1125,6 @@ yytnamerr (char *yyres, const char *yystr)
     {
       YYPTRDIFF_T yyn = 0;
       char const *yyp = yystr;
-
       for (;;)
         switch (*++yyp)
           {
@@ -1103,31 +1158,15 @@ yytnamerr (char *yyres, const char *yystr)
   else
     return yystrlen (yystr);
 }
-# endif
+#endif
 
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
 
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
 static int
-yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
-                yy_state_t *yyssp, int yytoken)
+yy_syntax_error_arguments (const yypcontext_t *yyctx,
+                           yysymbol_kind_t yyarg[], int yyargn)
 {
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = YY_NULLPTR;
-  /* Arguments of yyformat: reported tokens (one for the "unexpected",
-     one per "expected"). */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
   /* Actual size of YYARG. */
   int yycount = 0;
-  /* Cumulated lengths of YYARG.  */
-  YYPTRDIFF_T yysize = 0;
-
   /* There are many possibilities here to consider:
      - If this state is a consistent state with a default action, then
        the only way this function was invoked is if the default action
@@ -1151,52 +1190,54 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
        one exception: it will still contain any token that will not be
        accepted due to an error action in a later state.
   */
-  if (yytoken != YYEMPTY)
+  if (yyctx->yytoken != YYSYMBOL_YYEMPTY)
     {
-      int yyn = yypact[+*yyssp];
-      YYPTRDIFF_T yysize0 = yytnamerr (YY_NULLPTR, yytname[yytoken]);
-      yysize = yysize0;
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                {
-                  YYPTRDIFF_T yysize1
-                    = yysize + yytnamerr (YY_NULLPTR, yytname[yyx]);
-                  if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
-                    yysize = yysize1;
-                  else
-                    return 2;
-                }
-              }
-        }
+      int yyn;
+      if (yyarg)
+        yyarg[yycount] = yyctx->yytoken;
+      ++yycount;
+      yyn = yypcontext_expected_tokens (yyctx,
+                                        yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+      if (yyn == YYENOMEM)
+        return YYENOMEM;
+      else
+        yycount += yyn;
     }
+  return yycount;
+}
+
+/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
+   about the unexpected token YYTOKEN for the state stack whose top is
+   YYSSP.
+
+   Return 0 if *YYMSG was successfully written.  Return -1 if *YYMSG is
+   not large enough to hold the message.  In that case, also set
+   *YYMSG_ALLOC to the required number of bytes.  Return YYENOMEM if the
+   required number of bytes is too large to store.  */
+static int
+yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
+                const yypcontext_t *yyctx)
+{
+  enum { YYARGS_MAX = 5 };
+  /* Internationalized format string. */
+  const char *yyformat = YY_NULLPTR;
+  /* Arguments of yyformat: reported tokens (one for the "unexpected",
+     one per "expected"). */
+  yysymbol_kind_t yyarg[YYARGS_MAX];
+  /* Cumulated lengths of YYARG.  */
+  YYPTRDIFF_T yysize = 0;
+
+  /* Actual size of YYARG. */
+  int yycount = yy_syntax_error_arguments (yyctx, yyarg, YYARGS_MAX);
+  if (yycount == YYENOMEM)
+    return YYENOMEM;
 
   switch (yycount)
     {
-# define YYCASE_(N, S)                      \
+#define YYCASE_(N, S)                       \
       case N:                               \
         yyformat = S;                       \
-      break
+        break
     default: /* Avoid compiler warnings. */
       YYCASE_(0, YY_("syntax error"));
       YYCASE_(1, YY_("syntax error, unexpected %s"));
@@ -1204,17 +1245,23 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
       YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
       YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
       YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
+#undef YYCASE_
     }
 
+  /* Compute error message size.  Don't count the "%s"s, but reserve
+     room for the terminator.  */
+  yysize = yystrlen (yyformat) - 2 * yycount + 1;
   {
-    /* Don't count the "%s"s in the final size, but reserve room for
-       the terminator.  */
-    YYPTRDIFF_T yysize1 = yysize + (yystrlen (yyformat) - 2 * yycount) + 1;
-    if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
-      yysize = yysize1;
-    else
-      return 2;
+    int yyi;
+    for (yyi = 0; yyi < yycount; ++yyi)
+      {
+        YYPTRDIFF_T yysize1
+          = yysize + yytnamerr (YY_NULLPTR, yytname[yyarg[yyi]]);
+        if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
+          yysize = yysize1;
+        else
+          return YYENOMEM;
+      }
   }
 
   if (*yymsg_alloc < yysize)
@@ -1223,7 +1270,7 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
       if (! (yysize <= *yymsg_alloc
              && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
         *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
+      return -1;
     }
 
   /* Avoid sprintf, as that infringes on the user's name space.
@@ -1235,7 +1282,7 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
     while ((*yyp = *yyformat) != '\0')
       if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
         {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
+          yyp += yytnamerr (yyp, yytname[yyarg[yyi++]]);
           yyformat += 2;
         }
       else
@@ -1246,30 +1293,29 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
   }
   return 0;
 }
-#endif /* YYERROR_VERBOSE */
+
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, YYLTYPE *yylocationp)
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, YYLTYPE *yylocationp)
 {
-  YYUSE (yyvaluep);
-  YYUSE (yylocationp);
+  YY_USE (yyvaluep);
+  YY_USE (yylocationp);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-
-
-/* The lookahead symbol.  */
+/* Lookahead token kind.  */
 int yychar;
 
 /* The semantic value of the lookahead symbol.  */
@@ -1284,6 +1330,8 @@ YYLTYPE yylloc
 int yynerrs;
 
 
+
+
 /*----------.
 | yyparse.  |
 `----------*/
@@ -1291,53 +1339,48 @@ int yynerrs;
 int
 yyparse (void)
 {
-    yy_state_fast_t yystate;
+    yy_state_fast_t yystate = 0;
     /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
+    int yyerrstatus = 0;
 
-    /* The stacks and their tools:
-       'yyss': related to states.
-       'yyvs': related to semantic values.
-       'yyls': related to locations.
-
-       Refer to the stacks through separate pointers, to allow yyoverflow
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
     yy_state_t yyssa[YYINITDEPTH];
-    yy_state_t *yyss;
-    yy_state_t *yyssp;
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-    /* The semantic value stack.  */
+    /* The semantic value stack: array, bottom, top.  */
     YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
-    /* The location stack.  */
+    /* The location stack: array, bottom, top.  */
     YYLTYPE yylsa[YYINITDEPTH];
-    YYLTYPE *yyls;
-    YYLTYPE *yylsp;
-
-    /* The locations where the error started and ended.  */
-    YYLTYPE yyerror_range[3];
-
-    YYPTRDIFF_T yystacksize;
+    YYLTYPE *yyls = yylsa;
+    YYLTYPE *yylsp = yyls;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken = 0;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
   YYLTYPE yyloc;
 
-#if YYERROR_VERBOSE
+  /* The locations where the error started and ended.  */
+  YYLTYPE yyerror_range[3];
+
   /* Buffer for error messages, and its allocated size.  */
   char yymsgbuf[128];
   char *yymsg = yymsgbuf;
   YYPTRDIFF_T yymsg_alloc = sizeof yymsgbuf;
-#endif
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N), yylsp -= (N))
 
@@ -1345,17 +1388,10 @@ yyparse (void)
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yyssp = yyss = yyssa;
-  yyvsp = yyvs = yyvsa;
-  yylsp = yyls = yylsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
+
   yylsp[0] = yylloc;
   goto yysetstate;
 
@@ -1378,10 +1414,11 @@ yysetstate:
   YY_IGNORE_USELESS_CAST_BEGIN
   *yyssp = YY_CAST (yy_state_t, yystate);
   YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
 #if !defined yyoverflow && !defined YYSTACK_RELOCATE
-    goto yyexhaustedlab;
+    YYNOMEM;
 #else
     {
       /* Get the current used size of the three stacks, in elements.  */
@@ -1412,7 +1449,7 @@ yysetstate:
 # else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-        goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
         yystacksize = YYMAXDEPTH;
@@ -1423,11 +1460,11 @@ yysetstate:
           YY_CAST (union yyalloc *,
                    YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
         if (! yyptr)
-          goto yyexhaustedlab;
+          YYNOMEM;
         YYSTACK_RELOCATE (yyss_alloc, yyss);
         YYSTACK_RELOCATE (yyvs_alloc, yyvs);
         YYSTACK_RELOCATE (yyls_alloc, yyls);
-# undef YYSTACK_RELOCATE
+#  undef YYSTACK_RELOCATE
         if (yyss1 != yyssa)
           YYSTACK_FREE (yyss1);
       }
@@ -1447,6 +1484,7 @@ yysetstate:
     }
 #endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
+
   if (yystate == YYFINAL)
     YYACCEPT;
 
@@ -1467,18 +1505,30 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
+      YYDPRINTF ((stderr, "Reading a token\n"));
       yychar = yylex ();
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      yyerror_range[1] = yylloc;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1550,386 +1600,386 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-  case 2:
-#line 51 "syntax.y"
-                        {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "Program", 1, (yyvsp[0].node)); root = (yyval.node);}
-#line 1557 "syntax.tab.c"
-    break;
-
-  case 3:
-#line 53 "syntax.y"
-                                  {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "ExtDefList", 2, (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1563 "syntax.tab.c"
-    break;
-
-  case 4:
+  case 2: /* Program: ExtDefList  */
 #line 54 "syntax.y"
-         {(yyval.node) = NULL;}
-#line 1569 "syntax.tab.c"
+                        {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_Program, 1, (yyvsp[0].node)); root = (yyval.node);}
+#line 1607 "syntax.tab.c"
     break;
 
-  case 5:
+  case 3: /* ExtDefList: ExtDefList ExtDef  */
 #line 56 "syntax.y"
-                                      {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "ExtDef", 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1575 "syntax.tab.c"
+                                  {(yyval.node) = addExtDef((yyvsp[-1].node), (yyvsp[0].node), (yylsp[0]).first_line);}
+#line 1613 "syntax.tab.c"
     break;
 
-  case 6:
+  case 4: /* ExtDefList: %empty  */
 #line 57 "syntax.y"
-                        {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "ExtDef", 2, (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1581 "syntax.tab.c"
+         {(yyval.node) = NULL;}
+#line 1619 "syntax.tab.c"
     break;
 
-  case 7:
-#line 58 "syntax.y"
-                                 {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "ExtDef", 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1587 "syntax.tab.c"
+  case 5: /* ExtDef: Specifier ExtDecList SEMI  */
+#line 59 "syntax.y"
+                                      {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_ExtDef, 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
+#line 1625 "syntax.tab.c"
     break;
 
-  case 8:
-#line 59 "syntax.y"
-                    {synError = 1;}
-#line 1593 "syntax.tab.c"
+  case 6: /* ExtDef: Specifier SEMI  */
+#line 60 "syntax.y"
+                        {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_ExtDef, 2, (yyvsp[-1].node), (yyvsp[0].node));}
+#line 1631 "syntax.tab.c"
     break;
 
-  case 9:
+  case 7: /* ExtDef: Specifier FunDec CompSt  */
 #line 61 "syntax.y"
-                       {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "ExtDecList", 1, (yyvsp[0].node));}
-#line 1599 "syntax.tab.c"
+                                 {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_ExtDef, 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
+#line 1637 "syntax.tab.c"
     break;
 
-  case 10:
+  case 8: /* ExtDef: error SEMI  */
 #line 62 "syntax.y"
-                                 {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "ExtDecList", 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1605 "syntax.tab.c"
+                    {synError = 1; (yyval.node) = NULL;}
+#line 1643 "syntax.tab.c"
     break;
 
-  case 11:
-#line 66 "syntax.y"
-                    {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "Specifier", 1, (yyvsp[0].node));}
-#line 1611 "syntax.tab.c"
+  case 9: /* ExtDecList: VarDec  */
+#line 64 "syntax.y"
+                       {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_ExtDecList, 1, (yyvsp[0].node));}
+#line 1649 "syntax.tab.c"
     break;
 
-  case 12:
-#line 67 "syntax.y"
-                         {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "Specifier", 1, (yyvsp[0].node));}
-#line 1617 "syntax.tab.c"
+  case 10: /* ExtDecList: VarDec COMMA ExtDecList  */
+#line 65 "syntax.y"
+                                 {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_ExtDecList, 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
+#line 1655 "syntax.tab.c"
     break;
 
-  case 13:
+  case 11: /* Specifier: TYPE  */
 #line 69 "syntax.y"
-                                                 {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "StructSpecifier", 5, (yyvsp[-4].node), (yyvsp[-3].node), (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1623 "syntax.tab.c"
+                    {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_Specifier, 1, (yyvsp[0].node));}
+#line 1661 "syntax.tab.c"
     break;
 
-  case 14:
+  case 12: /* Specifier: StructSpecifier  */
 #line 70 "syntax.y"
-                    {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "StructSpecifier", 2, (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1629 "syntax.tab.c"
+                         {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_Specifier, 1, (yyvsp[0].node));}
+#line 1667 "syntax.tab.c"
     break;
 
-  case 15:
+  case 13: /* StructSpecifier: STRUCT OptTag LC DefList RC  */
 #line 72 "syntax.y"
-               {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "OptTag", 1, (yyvsp[0].node));}
-#line 1635 "syntax.tab.c"
+                                                 {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_StructSpecifier, 5, (yyvsp[-4].node), (yyvsp[-3].node), (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
+#line 1673 "syntax.tab.c"
     break;
 
-  case 16:
+  case 14: /* StructSpecifier: STRUCT Tag  */
 #line 73 "syntax.y"
-         {(yyval.node) = NULL;}
-#line 1641 "syntax.tab.c"
+                    {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_StructSpecifier, 2, (yyvsp[-1].node), (yyvsp[0].node));}
+#line 1679 "syntax.tab.c"
     break;
 
-  case 17:
+  case 15: /* OptTag: ID  */
 #line 75 "syntax.y"
-            {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "Tag", 1, (yyvsp[0].node));}
-#line 1647 "syntax.tab.c"
+               {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_OptTag, 1, (yyvsp[0].node));}
+#line 1685 "syntax.tab.c"
     break;
 
-  case 18:
-#line 79 "syntax.y"
-               {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "VarDec", 1, (yyvsp[0].node));}
-#line 1653 "syntax.tab.c"
+  case 16: /* OptTag: %empty  */
+#line 76 "syntax.y"
+         {(yyval.node) = NULL;}
+#line 1691 "syntax.tab.c"
     break;
 
-  case 19:
-#line 80 "syntax.y"
-                          {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "VarDec", 4, (yyvsp[-3].node), (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1659 "syntax.tab.c"
+  case 17: /* Tag: ID  */
+#line 78 "syntax.y"
+            {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_Tag, 1, (yyvsp[0].node));}
+#line 1697 "syntax.tab.c"
     break;
 
-  case 20:
-#line 81 "syntax.y"
-                  {synError = 1;}
-#line 1665 "syntax.tab.c"
+  case 18: /* VarDec: ID  */
+#line 82 "syntax.y"
+               {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_VarDec, 1, (yyvsp[0].node));}
+#line 1703 "syntax.tab.c"
     break;
 
-  case 21:
+  case 19: /* VarDec: VarDec LB INT RB  */
 #line 83 "syntax.y"
-                             {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "FunDec", 4, (yyvsp[-3].node), (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1671 "syntax.tab.c"
+                          {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_VarDec, 4, (yyvsp[-3].node), (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
+#line 1709 "syntax.tab.c"
     break;
 
-  case 22:
+  case 20: /* VarDec: error RB  */
 #line 84 "syntax.y"
-                  {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "FunDec", 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1677 "syntax.tab.c"
+                  {synError = 1;}
+#line 1715 "syntax.tab.c"
     break;
 
-  case 23:
-#line 85 "syntax.y"
-                  {synError = 1;}
-#line 1683 "syntax.tab.c"
+  case 21: /* FunDec: ID LP VarList RP  */
+#line 86 "syntax.y"
+                             {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_FunDec, 4, (yyvsp[-3].node), (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
+#line 1721 "syntax.tab.c"
     break;
 
-  case 24:
+  case 22: /* FunDec: ID LP RP  */
 #line 87 "syntax.y"
-                                    {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "VarList", 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1689 "syntax.tab.c"
+                  {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_FunDec, 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
+#line 1727 "syntax.tab.c"
     break;
 
-  case 25:
+  case 23: /* FunDec: error RP  */
 #line 88 "syntax.y"
-                  {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "VarList", 1, (yyvsp[0].node));}
-#line 1695 "syntax.tab.c"
+                  {synError = 1;}
+#line 1733 "syntax.tab.c"
     break;
 
-  case 26:
+  case 24: /* VarList: ParamDec COMMA VarList  */
 #line 90 "syntax.y"
-                               {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "ParamDec", 2, (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1701 "syntax.tab.c"
+                                    {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_VarList, 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
+#line 1739 "syntax.tab.c"
     break;
 
-  case 27:
-#line 94 "syntax.y"
-                                   {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "CompSt", 4, (yyvsp[-3].node), (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1707 "syntax.tab.c"
+  case 25: /* VarList: ParamDec  */
+#line 91 "syntax.y"
+                  {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_VarList, 1, (yyvsp[0].node));}
+#line 1745 "syntax.tab.c"
     break;
 
-  case 28:
-#line 95 "syntax.y"
-                  {synError = 1;}
-#line 1713 "syntax.tab.c"
+  case 26: /* ParamDec: Specifier VarDec  */
+#line 93 "syntax.y"
+                               {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_ParamDec, 2, (yyvsp[-1].node), (yyvsp[0].node));}
+#line 1751 "syntax.tab.c"
     break;
 
-  case 29:
+  case 27: /* CompSt: LC DefList StmtList RC  */
 #line 97 "syntax.y"
-                            {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "StmtList", 2, (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1719 "syntax.tab.c"
+                                   {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_CompSt, 4, (yyvsp[-3].node), (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
+#line 1757 "syntax.tab.c"
     break;
 
-  case 30:
+  case 28: /* CompSt: error RC  */
 #line 98 "syntax.y"
-         {(yyval.node) = NULL;}
-#line 1725 "syntax.tab.c"
+                  {synError = 1;}
+#line 1763 "syntax.tab.c"
     break;
 
-  case 31:
+  case 29: /* StmtList: Stmt StmtList  */
 #line 100 "syntax.y"
-                   {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "Stmt", 2, (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1731 "syntax.tab.c"
+                            {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_StmtList, 2, (yyvsp[-1].node), (yyvsp[0].node));}
+#line 1769 "syntax.tab.c"
     break;
 
-  case 32:
+  case 30: /* StmtList: %empty  */
 #line 101 "syntax.y"
-                {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "Stmt", 1, (yyvsp[0].node));}
-#line 1737 "syntax.tab.c"
-    break;
-
-  case 33:
-#line 102 "syntax.y"
-                         {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "Stmt", 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1743 "syntax.tab.c"
+         {(yyval.node) = NULL;}
+#line 1775 "syntax.tab.c"
     break;
 
-  case 34:
+  case 31: /* Stmt: Exp SEMI  */
 #line 103 "syntax.y"
-                                                 {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "Stmt", 5, (yyvsp[-4].node), (yyvsp[-3].node), (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1749 "syntax.tab.c"
+                   {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_Stmt, 2, (yyvsp[-1].node), (yyvsp[0].node)); (yyval.node)->prod = P_STMT_EXP;}
+#line 1781 "syntax.tab.c"
     break;
 
-  case 35:
+  case 32: /* Stmt: CompSt  */
 #line 104 "syntax.y"
-                                     {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "Stmt", 7, (yyvsp[-6].node), (yyvsp[-5].node), (yyvsp[-4].node), (yyvsp[-3].node), (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1755 "syntax.tab.c"
+                {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_Stmt, 1, (yyvsp[0].node)); (yyval.node)->prod = P_STMT_COMPST;}
+#line 1787 "syntax.tab.c"
     break;
 
-  case 36:
+  case 33: /* Stmt: RETURN Exp SEMI  */
 #line 105 "syntax.y"
-                              {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "Stmt", 5, (yyvsp[-4].node), (yyvsp[-3].node), (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1761 "syntax.tab.c"
+                         {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_Stmt, 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node)); (yyval.node)->prod = P_STMT_RETURN;}
+#line 1793 "syntax.tab.c"
     break;
 
-  case 37:
+  case 34: /* Stmt: IF LP Exp RP Stmt  */
 #line 106 "syntax.y"
-                    {synError = 1;}
-#line 1767 "syntax.tab.c"
+                                                 {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_Stmt, 5, (yyvsp[-4].node), (yyvsp[-3].node), (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node)); (yyval.node)->prod = P_STMT_IF;}
+#line 1799 "syntax.tab.c"
     break;
 
-  case 38:
-#line 110 "syntax.y"
-                         {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "DefList", 2, (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1773 "syntax.tab.c"
+  case 35: /* Stmt: IF LP Exp RP Stmt ELSE Stmt  */
+#line 107 "syntax.y"
+                                     {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_Stmt, 7, (yyvsp[-6].node), (yyvsp[-5].node), (yyvsp[-4].node), (yyvsp[-3].node), (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node)); (yyval.node)->prod = P_STMT_IF_ELSE;}
+#line 1805 "syntax.tab.c"
     break;
 
-  case 39:
-#line 111 "syntax.y"
-         {(yyval.node) = NULL;}
-#line 1779 "syntax.tab.c"
+  case 36: /* Stmt: WHILE LP Exp RP Stmt  */
+#line 108 "syntax.y"
+                              {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_Stmt, 5, (yyvsp[-4].node), (yyvsp[-3].node), (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node)); (yyval.node)->prod = P_STMT_WHILE;}
+#line 1811 "syntax.tab.c"
     break;
 
-  case 40:
+  case 37: /* Stmt: error SEMI  */
+#line 109 "syntax.y"
+                    {synError = 1;}
+#line 1817 "syntax.tab.c"
+    break;
+
+  case 38: /* DefList: Def DefList  */
 #line 113 "syntax.y"
-                                {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "Def", 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1785 "syntax.tab.c"
+                         {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_DefList, 2, (yyvsp[-1].node), (yyvsp[0].node));}
+#line 1823 "syntax.tab.c"
     break;
 
-  case 41:
-#line 115 "syntax.y"
-                 {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "DecList", 1, (yyvsp[0].node));}
-#line 1791 "syntax.tab.c"
+  case 39: /* DefList: %empty  */
+#line 114 "syntax.y"
+         {(yyval.node) = NULL;}
+#line 1829 "syntax.tab.c"
     break;
 
-  case 42:
+  case 40: /* Def: Specifier DecList SEMI  */
 #line 116 "syntax.y"
-                           {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "DecList", 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1797 "syntax.tab.c"
+                                {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_Def, 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
+#line 1835 "syntax.tab.c"
     break;
 
-  case 43:
+  case 41: /* DecList: Dec  */
 #line 118 "syntax.y"
-                {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "Dec", 1, (yyvsp[0].node));}
-#line 1803 "syntax.tab.c"
+                 {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_DecList, 1, (yyvsp[0].node));}
+#line 1841 "syntax.tab.c"
     break;
 
-  case 44:
+  case 42: /* DecList: Dec COMMA DecList  */
 #line 119 "syntax.y"
-                             {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "Dec", 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1809 "syntax.tab.c"
-    break;
-
-  case 45:
-#line 123 "syntax.y"
-                         {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "Exp", 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1815 "syntax.tab.c"
+                           {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_DecList, 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
+#line 1847 "syntax.tab.c"
     break;
 
-  case 46:
-#line 124 "syntax.y"
-                     {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "Exp", 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1821 "syntax.tab.c"
+  case 43: /* Dec: VarDec  */
+#line 121 "syntax.y"
+                {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_Dec, 1, (yyvsp[0].node));}
+#line 1853 "syntax.tab.c"
     break;
 
-  case 47:
-#line 125 "syntax.y"
-                    {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "Exp", 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1827 "syntax.tab.c"
+  case 44: /* Dec: VarDec ASSIGNOP Exp  */
+#line 122 "syntax.y"
+                             {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_Dec, 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
+#line 1859 "syntax.tab.c"
     break;
 
-  case 48:
+  case 45: /* Exp: Exp ASSIGNOP Exp  */
 #line 126 "syntax.y"
-                       {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "Exp", 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1833 "syntax.tab.c"
+                         {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_Exp, 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node)); (yyval.node)->prod = P_EXP_ASSIGNOP;}
+#line 1865 "syntax.tab.c"
     break;
 
-  case 49:
+  case 46: /* Exp: Exp AND Exp  */
 #line 127 "syntax.y"
-                      {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "Exp", 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1839 "syntax.tab.c"
+                     {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_Exp, 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node)); (yyval.node)->prod = P_EXP_AND;}
+#line 1871 "syntax.tab.c"
     break;
 
-  case 50:
+  case 47: /* Exp: Exp OR Exp  */
 #line 128 "syntax.y"
-                       {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "Exp", 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1845 "syntax.tab.c"
+                    {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_Exp, 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node)); (yyval.node)->prod = P_EXP_OR;}
+#line 1877 "syntax.tab.c"
     break;
 
-  case 51:
+  case 48: /* Exp: Exp RELOP Exp  */
 #line 129 "syntax.y"
-                      {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "Exp", 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1851 "syntax.tab.c"
+                       {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_Exp, 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node)); (yyval.node)->prod = P_EXP_RELOP;}
+#line 1883 "syntax.tab.c"
     break;
 
-  case 52:
+  case 49: /* Exp: Exp PLUS Exp  */
 #line 130 "syntax.y"
-                     {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "Exp", 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1857 "syntax.tab.c"
+                      {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_Exp, 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node)); (yyval.node)->prod = P_EXP_PLUS;}
+#line 1889 "syntax.tab.c"
     break;
 
-  case 53:
+  case 50: /* Exp: Exp MINUS Exp  */
 #line 131 "syntax.y"
-                   {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "Exp", 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1863 "syntax.tab.c"
+                       {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_Exp, 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node)); (yyval.node)->prod = P_EXP_MINUS;}
+#line 1895 "syntax.tab.c"
     break;
 
-  case 54:
+  case 51: /* Exp: Exp STAR Exp  */
 #line 132 "syntax.y"
-                   {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "Exp", 2, (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1869 "syntax.tab.c"
+                      {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_Exp, 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node)); (yyval.node)->prod = P_EXP_STAR;}
+#line 1901 "syntax.tab.c"
     break;
 
-  case 55:
+  case 52: /* Exp: Exp DIV Exp  */
 #line 133 "syntax.y"
-                 {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "Exp", 2, (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1875 "syntax.tab.c"
+                     {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_Exp, 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node)); (yyval.node)->prod = P_EXP_DIV;}
+#line 1907 "syntax.tab.c"
     break;
 
-  case 56:
+  case 53: /* Exp: LP Exp RP  */
 #line 134 "syntax.y"
-                       {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "Exp", 4, (yyvsp[-3].node), (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1881 "syntax.tab.c"
+                   {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_Exp, 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node)); (yyval.node)->prod = P_EXP_PAREN;}
+#line 1913 "syntax.tab.c"
     break;
 
-  case 57:
+  case 54: /* Exp: MINUS Exp  */
 #line 135 "syntax.y"
-                  {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "Exp", 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1887 "syntax.tab.c"
+                   {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_Exp, 2, (yyvsp[-1].node), (yyvsp[0].node)); (yyval.node)->prod = P_EXP_NEG;}
+#line 1919 "syntax.tab.c"
     break;
 
-  case 58:
+  case 55: /* Exp: NOT Exp  */
 #line 136 "syntax.y"
-                       {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "Exp", 4, (yyvsp[-3].node), (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1893 "syntax.tab.c"
+                 {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_Exp, 2, (yyvsp[-1].node), (yyvsp[0].node)); (yyval.node)->prod = P_EXP_NOT;}
+#line 1925 "syntax.tab.c"
     break;
 
-  case 59:
+  case 56: /* Exp: ID LP Args RP  */
 #line 137 "syntax.y"
-                    {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "Exp", 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1899 "syntax.tab.c"
+                       {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_Exp, 4, (yyvsp[-3].node), (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node)); (yyval.node)->prod = P_EXP_CALL_ARGS;}
+#line 1931 "syntax.tab.c"
     break;
 
-  case 60:
+  case 57: /* Exp: ID LP RP  */
 #line 138 "syntax.y"
-            {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "Exp", 1, (yyvsp[0].node));}
-#line 1905 "syntax.tab.c"
+                  {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_Exp, 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node)); (yyval.node)->prod = P_EXP_CALL;}
+#line 1937 "syntax.tab.c"
     break;
 
-  case 61:
+  case 58: /* Exp: Exp LB Exp RB  */
 #line 139 "syntax.y"
-             {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "Exp", 1, (yyvsp[0].node));}
-#line 1911 "syntax.tab.c"
+                       {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_Exp, 4, (yyvsp[-3].node), (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node)); (yyval.node)->prod = P_EXP_INDEX;}
+#line 1943 "syntax.tab.c"
     break;
 
-  case 62:
+  case 59: /* Exp: Exp DOT ID  */
 #line 140 "syntax.y"
-               {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "Exp", 1, (yyvsp[0].node));}
-#line 1917 "syntax.tab.c"
+                    {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_Exp, 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node)); (yyval.node)->prod = P_EXP_FIELD;}
+#line 1949 "syntax.tab.c"
+    break;
+
+  case 60: /* Exp: ID  */
+#line 141 "syntax.y"
+            {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_Exp, 1, (yyvsp[0].node)); (yyval.node)->prod = P_EXP_ID;}
+#line 1955 "syntax.tab.c"
     break;
 
-  case 63:
+  case 61: /* Exp: INT  */
 #line 142 "syntax.y"
-                         {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "Args", 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
-#line 1923 "syntax.tab.c"
+             {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_Exp, 1, (yyvsp[0].node)); (yyval.node)->prod = P_EXP_INT;}
+#line 1961 "syntax.tab.c"
     break;
 
-  case 64:
+  case 62: /* Exp: FLOAT  */
 #line 143 "syntax.y"
-             {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, "Args", 1, (yyvsp[0].node));}
-#line 1929 "syntax.tab.c"
+               {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_Exp, 1, (yyvsp[0].node)); (yyval.node)->prod = P_EXP_FLOAT;}
+#line 1967 "syntax.tab.c"
+    break;
+
+  case 63: /* Args: Exp COMMA Args  */
+#line 145 "syntax.y"
+                         {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_Args, 3, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));}
+#line 1973 "syntax.tab.c"
+    break;
+
+  case 64: /* Args: Exp  */
+#line 146 "syntax.y"
+             {(yyval.node) = newNode((yyloc).first_line, NOT_A_TOKEN, N_Args, 1, (yyvsp[0].node));}
+#line 1979 "syntax.tab.c"
     break;
 
 
-#line 1933 "syntax.tab.c"
+#line 1983 "syntax.tab.c"
 
       default: break;
     }
@@ -1944,11 +1994,10 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
   *++yylsp = yyloc;
@@ -1973,50 +2022,45 @@ yyreduce:
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
-      yyerror (YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
       {
+        yypcontext_t yyctx
+          = {yyssp, yytoken, &yylloc};
         char const *yymsgp = YY_("syntax error");
         int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
+        yysyntax_error_status = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
         if (yysyntax_error_status == 0)
           yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
+        else if (yysyntax_error_status == -1)
           {
             if (yymsg != yymsgbuf)
               YYSTACK_FREE (yymsg);
-            yymsg = YY_CAST (char *, YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
-            if (!yymsg)
+            yymsg = YY_CAST (char *,
+                             YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
+            if (yymsg)
               {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
+                yysyntax_error_status
+                  = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+                yymsgp = yymsg;
               }
             else
               {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
+                yymsg = yymsgbuf;
+                yymsg_alloc = sizeof yymsgbuf;
+                yysyntax_error_status = YYENOMEM;
               }
           }
         yyerror (yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
+        if (yysyntax_error_status == YYENOMEM)
+          YYNOMEM;
       }
-# undef YYSYNTAX_ERROR
-#endif
     }
 
   yyerror_range[1] = yylloc;
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
@@ -2049,6 +2093,7 @@ yyerrorlab:
      label yyerrorlab therefore never appears in user code.  */
   if (0)
     YYERROR;
+  ++yynerrs;
 
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
@@ -2065,13 +2110,14 @@ yyerrorlab:
 yyerrlab1:
   yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
         {
-          yyn += YYTERROR;
-          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
             {
               yyn = yytable[yyn];
               if (0 < yyn)
@@ -2085,7 +2131,7 @@ yyerrlab1:
 
       yyerror_range[1] = *yylsp;
       yydestruct ("Error: popping",
-                  yystos[yystate], yyvsp, yylsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, yylsp);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -2096,13 +2142,11 @@ yyerrlab1:
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 
   yyerror_range[2] = yylloc;
-  /* Using YYLLOC is tempting, but would change the location of
-     the lookahead.  YYLOC is available though.  */
-  YYLLOC_DEFAULT (yyloc, yyerror_range, 2);
-  *++yylsp = yyloc;
+  ++yylsp;
+  YYLLOC_DEFAULT (*yylsp, yyerror_range, 2);
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -2113,7 +2157,7 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
 
 
 /*-----------------------------------.
@@ -2121,24 +2165,22 @@ yyacceptlab:
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
 
-#if !defined yyoverflow || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
   yyerror (YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
 
 
-/*-----------------------------------------------------.
-| yyreturn -- parsing is finished, return the result.  |
-`-----------------------------------------------------*/
-yyreturn:
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
@@ -2154,21 +2196,45 @@ yyreturn:
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-                  yystos[+*yyssp], yyvsp, yylsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, yylsp);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
   if (yymsg != yymsgbuf)
     YYSTACK_FREE (yymsg);
-#endif
   return yyresult;
 }
-#line 146 "syntax.y"
 
+#line 149 "syntax.y"
+
+
+// ExtDefList is left recursive so the parser stack stays flat however many ExtDefs a file has,
+// the chain is still linked first ExtDef first as if it were right recursive
+static pNode extDefTail;
+
+pNode addExtDef(pNode list, pNode extDef, int line)
+{
+    if (extDef == NULL)
+        return list;
+    // streaming: hand the ExtDef over and drop it, unless a lookahead token still lives in the arena
+    if (extDefHandler != NULL)
+    {
+        extDefHandler(extDef);
+        if (yychar == YYEMPTY)
+            clearArena(nodeArena);
+        return NULL;
+    }
+    pNode cur = newNode(line, NOT_A_TOKEN, N_ExtDefList, 1, extDef);
+    if (list == NULL)
+        list = cur;
+    else
+        extDefTail->child->sibling = cur;
+    extDefTail = cur;
+    return list;
+}
 
 yyerror(char* msg)
 {
@@ -3,6 +3,9 @@
 #include "lex.yy.c"
 extern int synError;
 pNode root;
+pArena nodeArena;
+void (*extDefHandler)(pNode extDef);
+pNode addExtDef(pNode list, pNode extDef, int line);
 %}
 
 %locations
@@ -48,103 +51,128 @@ pNode root;
 %%
 
 /* High-level Definitions */
-Program : ExtDefList    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "Program", 1, $1); root = $$;}
+Program : ExtDefList    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_Program, 1, $1); root = $$;}
     ; 
-ExtDefList : ExtDef ExtDefList    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "ExtDefList", 2, $1, $2);}
+ExtDefList : ExtDefList ExtDef    {$$ = addExtDef($1, $2, @2.first_line);}
     |    {$$ = NULL;}
     ; 
-ExtDef : Specifier ExtDecList SEMI    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "ExtDef", 3, $1, $2, $3);}
-    | Specifier SEMI    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "ExtDef", 2, $1, $2);}
-    | Specifier FunDec CompSt    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "ExtDef", 3, $1, $2, $3);}
-    | error SEMI    {synError = 1;}
+ExtDef : Specifier ExtDecList SEMI    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_ExtDef, 3, $1, $2, $3);}
+    | Specifier SEMI    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_ExtDef, 2, $1, $2);}
+    | Specifier FunDec CompSt    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_ExtDef, 3, $1, $2, $3);}
+    | error SEMI    {synError = 1; $$ = NULL;}
     ; 
-ExtDecList : VarDec    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "ExtDecList", 1, $1);}
-    | VarDec COMMA ExtDecList    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "ExtDecList", 3, $1, $2, $3);}
+ExtDecList : VarDec    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_ExtDecList, 1, $1);}
+    | VarDec COMMA ExtDecList    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_ExtDecList, 3, $1, $2, $3);}
     ; 
 
 /* Specifiers */
-Specifier : TYPE    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "Specifier", 1, $1);}
-    | StructSpecifier    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "Specifier", 1, $1);}
+Specifier : TYPE    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_Specifier, 1, $1);}
+    | StructSpecifier    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_Specifier, 1, $1);}
     ; 
-StructSpecifier : STRUCT OptTag LC DefList RC    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "StructSpecifier", 5, $1, $2, $3, $4, $5);}
-    | STRUCT Tag    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "StructSpecifier", 2, $1, $2);}
+StructSpecifier : STRUCT OptTag LC DefList RC    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_StructSpecifier, 5, $1, $2, $3, $4, $5);}
+    | STRUCT Tag    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_StructSpecifier, 2, $1, $2);}
     ; 
-OptTag : ID    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "OptTag", 1, $1);}
+OptTag : ID    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_OptTag, 1, $1);}
     |    {$$ = NULL;}
     ; 
-Tag : ID    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "Tag", 1, $1);}
+Tag : ID    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_Tag, 1, $1);}
     ; 
 
 /* Declarators */
-VarDec : ID    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "VarDec", 1, $1);}
-    | VarDec LB INT RB    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "VarDec", 4, $1, $2, $3, $4);}
+VarDec : ID    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_VarDec, 1, $1);}
+    | VarDec LB INT RB    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_VarDec, 4, $1, $2, $3, $4);}
     | error RB    {synError = 1;}
     ; 
-FunDec : ID LP VarList RP    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "FunDec", 4, $1, $2, $3, $4);}
-    | ID LP RP    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "FunDec", 3, $1, $2, $3);}
+FunDec : ID LP VarList RP    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_FunDec, 4, $1, $2, $3, $4);}
+    | ID LP RP    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_FunDec, 3, $1, $2, $3);}
     | error RP    {synError = 1;}
     ; 
-VarList : ParamDec COMMA VarList    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "VarList", 3, $1, $2, $3);}
-    | ParamDec    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "VarList", 1, $1);}
+VarList : ParamDec COMMA VarList    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_VarList, 3, $1, $2, $3);}
+    | ParamDec    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_VarList, 1, $1);}
     ; 
-ParamDec : Specifier VarDec    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "ParamDec", 2, $1, $2);}
+ParamDec : Specifier VarDec    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_ParamDec, 2, $1, $2);}
     ; 
     
 /* Statements */
-CompSt : LC DefList StmtList RC    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "CompSt", 4, $1, $2, $3, $4);}
+CompSt : LC DefList StmtList RC    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_CompSt, 4, $1, $2, $3, $4);}
     | error RC    {synError = 1;}
     ; 
-StmtList : Stmt StmtList    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "StmtList", 2, $1, $2);}
+StmtList : Stmt StmtList    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_StmtList, 2, $1, $2);}
     |    {$$ = NULL;}
     ; 
-Stmt : Exp SEMI    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "Stmt", 2, $1, $2);}
-    | CompSt    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "Stmt", 1, $1);}
-    | RETURN Exp SEMI    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "Stmt", 3, $1, $2, $3);}    
-    | IF LP Exp RP Stmt %prec LOWER_THAN_ELSE    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "Stmt", 5, $1, $2, $3, $4, $5);}
-    | IF LP Exp RP Stmt ELSE Stmt    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "Stmt", 7, $1, $2, $3, $4, $5, $6, $7);}
-    | WHILE LP Exp RP Stmt    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "Stmt", 5, $1, $2, $3, $4, $5);}
+Stmt : Exp SEMI    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_Stmt, 2, $1, $2); $$->prod = P_STMT_EXP;}
+    | CompSt    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_Stmt, 1, $1); $$->prod = P_STMT_COMPST;}
+    | RETURN Exp SEMI    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_Stmt, 3, $1, $2, $3); $$->prod = P_STMT_RETURN;}
+    | IF LP Exp RP Stmt %prec LOWER_THAN_ELSE    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_Stmt, 5, $1, $2, $3, $4, $5); $$->prod = P_STMT_IF;}
+    | IF LP Exp RP Stmt ELSE Stmt    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_Stmt, 7, $1, $2, $3, $4, $5, $6, $7); $$->prod = P_STMT_IF_ELSE;}
+    | WHILE LP Exp RP Stmt    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_Stmt, 5, $1, $2, $3, $4, $5); $$->prod = P_STMT_WHILE;}
     | error SEMI    {synError = 1;}
     ; 
     
 /* Local Definitions */
-DefList : Def DefList    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "DefList", 2, $1, $2);}
+DefList : Def DefList    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_DefList, 2, $1, $2);}
     |    {$$ = NULL;}
     ;     
-Def : Specifier DecList SEMI    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "Def", 3, $1, $2, $3);}
+Def : Specifier DecList SEMI    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_Def, 3, $1, $2, $3);}
     ; 
-DecList : Dec    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "DecList", 1, $1);}
-    | Dec COMMA DecList    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "DecList", 3, $1, $2, $3);}
+DecList : Dec    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_DecList, 1, $1);}
+    | Dec COMMA DecList    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_DecList, 3, $1, $2, $3);}
     ;
-Dec : VarDec    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "Dec", 1, $1);}
-    | VarDec ASSIGNOP Exp    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "Dec", 3, $1, $2, $3);}
+Dec : VarDec    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_Dec, 1, $1);}
+    | VarDec ASSIGNOP Exp    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_Dec, 3, $1, $2, $3);}
     ;
     
 /* Expressions */
-Exp : Exp ASSIGNOP Exp   {$$ = newNode(@$.first_line, NOT_A_TOKEN, "Exp", 3, $1, $2, $3);}
-    | Exp AND Exp    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "Exp", 3, $1, $2, $3);}
-    | Exp OR Exp    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "Exp", 3, $1, $2, $3);}
-    | Exp RELOP Exp    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "Exp", 3, $1, $2, $3);}
-    | Exp PLUS Exp    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "Exp", 3, $1, $2, $3);}
-    | Exp MINUS Exp    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "Exp", 3, $1, $2, $3);}
-    | Exp STAR Exp    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "Exp", 3, $1, $2, $3);}
-    | Exp DIV Exp    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "Exp", 3, $1, $2, $3);}
-    | LP Exp RP    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "Exp", 3, $1, $2, $3);}
-    | MINUS Exp    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "Exp", 2, $1, $2);}
-    | NOT Exp    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "Exp", 2, $1, $2);}
-    | ID LP Args RP    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "Exp", 4, $1, $2, $3, $4);}
-    | ID LP RP    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "Exp", 3, $1, $2, $3);}
-    | Exp LB Exp RB    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "Exp", 4, $1, $2, $3, $4);}
-    | Exp DOT ID    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "Exp", 3, $1, $2, $3);}
-    | ID    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "Exp", 1, $1);}
-    | INT    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "Exp", 1, $1);}
-    | FLOAT    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "Exp", 1, $1);}
-    ; 
-Args : Exp COMMA Args    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "Args", 3, $1, $2, $3);}
-    | Exp    {$$ = newNode(@$.first_line, NOT_A_TOKEN, "Args", 1, $1);}
+Exp : Exp ASSIGNOP Exp   {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_Exp, 3, $1, $2, $3); $$->prod = P_EXP_ASSIGNOP;}
+    | Exp AND Exp    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_Exp, 3, $1, $2, $3); $$->prod = P_EXP_AND;}
+    | Exp OR Exp    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_Exp, 3, $1, $2, $3); $$->prod = P_EXP_OR;}
+    | Exp RELOP Exp    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_Exp, 3, $1, $2, $3); $$->prod = P_EXP_RELOP;}
+    | Exp PLUS Exp    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_Exp, 3, $1, $2, $3); $$->prod = P_EXP_PLUS;}
+    | Exp MINUS Exp    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_Exp, 3, $1, $2, $3); $$->prod = P_EXP_MINUS;}
+    | Exp STAR Exp    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_Exp, 3, $1, $2, $3); $$->prod = P_EXP_STAR;}
+    | Exp DIV Exp    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_Exp, 3, $1, $2, $3); $$->prod = P_EXP_DIV;}
+    | LP Exp RP    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_Exp, 3, $1, $2, $3); $$->prod = P_EXP_PAREN;}
+    | MINUS Exp    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_Exp, 2, $1, $2); $$->prod = P_EXP_NEG;}
+    | NOT Exp    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_Exp, 2, $1, $2); $$->prod = P_EXP_NOT;}
+    | ID LP Args RP    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_Exp, 4, $1, $2, $3, $4); $$->prod = P_EXP_CALL_ARGS;}
+    | ID LP RP    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_Exp, 3, $1, $2, $3); $$->prod = P_EXP_CALL;}
+    | Exp LB Exp RB    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_Exp, 4, $1, $2, $3, $4); $$->prod = P_EXP_INDEX;}
+    | Exp DOT ID    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_Exp, 3, $1, $2, $3); $$->prod = P_EXP_FIELD;}
+    | ID    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_Exp, 1, $1); $$->prod = P_EXP_ID;}
+    | INT    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_Exp, 1, $1); $$->prod = P_EXP_INT;}
+    | FLOAT    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_Exp, 1, $1); $$->prod = P_EXP_FLOAT;}
+    ; 
+Args : Exp COMMA Args    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_Args, 3, $1, $2, $3);}
+    | Exp    {$$ = newNode(@$.first_line, NOT_A_TOKEN, N_Args, 1, $1);}
     ; 
 
 %%
 
+// ExtDefList is left recursive so the parser stack stays flat however many ExtDefs a file has,
+// the chain is still linked first ExtDef first as if it were right recursive
+static pNode extDefTail;
+
+pNode addExtDef(pNode list, pNode extDef, int line)
+{
+    if (extDef == NULL)
+        return list;
+    // streaming: hand the ExtDef over and drop it, unless a lookahead token still lives in the arena
+    if (extDefHandler != NULL)
+    {
+        extDefHandler(extDef);
+        if (yychar == YYEMPTY)
+            clearArena(nodeArena);
+        return NULL;
+    }
+    pNode cur = newNode(line, NOT_A_TOKEN, N_ExtDefList, 1, extDef);
+    if (list == NULL)
+        list = cur;
+    else
+        extDefTail->child->sibling = cur;
+    extDefTail = cur;
+    return list;
+}
+
 yyerror(char* msg)
 {
     fprintf(stderr, "Error type B at line %d: %s.\n", yylineno, msg);
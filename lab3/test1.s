@@ -0,0 +1,53 @@
+.data
+_prompt: .asciiz "Enter an integer:"
+_ret: .asciiz "\n"
+.globl main
+.text
+read:
+  li $v0, 4
+  la $a0, _prompt
+  syscall
+  li $v0, 5
+  syscall
+  jr $ra
+
+write:
+  li $v0, 1
+  syscall
+  li $v0, 4
+  la $a0, _ret
+  syscall
+  move $v0, $0
+  jr $ra
+
+main:
+  sw $ra, -4($sp)
+  sw $fp, -8($sp)
+  move $fp, $sp
+  addi $sp, $sp, -8
+  jal read
+  move $t0, $v0
+  bgt $t0, $zero, label1
+  j label2
+label1:
+  li $a0, 1
+  jal write
+  j label3
+label2:
+  blt $t0, $zero, label4
+  j label5
+label4:
+  addi $t0, $zero, -1
+  move $a0, $t0
+  jal write
+  j label6
+label5:
+  move $a0, $zero
+  jal write
+label6:
+label3:
+  move $v0, $zero
+  move $sp, $fp
+  lw $ra, -4($fp)
+  lw $fp, -8($fp)
+  jr $ra
@@ -0,0 +1,107 @@
+    .local cmm_memory
+    .comm cmm_memory, 67108864, 16
+cmm_read:
+    pushq %rbp
+    movq %rsp, %rbp
+    pushq %rcx
+    pushq %rsi
+    pushq %rdi
+    pushq %r8
+    pushq %r9
+    pushq %r10
+    subq $8, %rsp
+    andq $-16, %rsp
+    movl $0, (%rsp)
+    movq %rsp, %rsi
+    leaq .Lcmm_in(%rip), %rdi
+    xorl %eax, %eax
+    call scanf@PLT
+    movl (%rsp), %eax
+    leaq -48(%rbp), %rsp
+    popq %r10
+    popq %r9
+    popq %r8
+    popq %rdi
+    popq %rsi
+    popq %rcx
+    popq %rbp
+    ret
+
+cmm_write:
+    pushq %rbp
+    movq %rsp, %rbp
+    pushq %rcx
+    pushq %rsi
+    pushq %rdi
+    pushq %r8
+    pushq %r9
+    pushq %r10
+    andq $-16, %rsp
+    movl %eax, %esi
+    leaq .Lcmm_out(%rip), %rdi
+    xorl %eax, %eax
+    call printf@PLT
+    leaq -48(%rbp), %rsp
+    popq %r10
+    popq %r9
+    popq %r8
+    popq %rdi
+    popq %rsi
+    popq %rcx
+    popq %rbp
+    ret
+
+    .section .rodata
+.Lcmm_in:
+    .string "%d"
+.Lcmm_out:
+    .string "%d\n"
+    .section .note.GNU-stack, "", @progbits
+    .text
+    .globl main
+main:
+    pushq %rbp
+    movq %rsp, %rbp
+    pushq %r14
+    pushq %r15
+    leaq cmm_memory(%rip), %r15
+    movl $67108864, %r14d
+    call cmm_main
+    popq %r15
+    popq %r14
+    popq %rbp
+    ret
+
+cmm_main:
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $8, %rsp
+    movq %rbx, -8(%rbp)
+    call cmm_read
+    movl %eax, %ebx
+    cmpl $0, %ebx
+    jg label1
+    jmp label2
+label1:
+    movl $1, %eax
+    call cmm_write
+    jmp label3
+label2:
+    cmpl $0, %ebx
+    jl label4
+    jmp label5
+label4:
+    movl $0, %ebx
+    subl $1, %ebx
+    movl %ebx, %eax
+    call cmm_write
+    jmp label6
+label5:
+    movl $0, %eax
+    call cmm_write
+label6:
+label3:
+    movl $0, %eax
+    movq -8(%rbp), %rbx
+    leave
+    ret
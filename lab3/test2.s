@@ -0,0 +1,85 @@
+.data
+_prompt: .asciiz "Enter an integer:"
+_ret: .asciiz "\n"
+.globl main
+.text
+read:
+  li $v0, 4
+  la $a0, _prompt
+  syscall
+  li $v0, 5
+  syscall
+  jr $ra
+
+write:
+  li $v0, 1
+  syscall
+  li $v0, 4
+  la $a0, _ret
+  syscall
+  move $v0, $0
+  jr $ra
+
+f_fact:
+  sw $ra, -4($sp)
+  sw $fp, -8($sp)
+  move $fp, $sp
+  addi $sp, $sp, -12
+  sw $s0, -12($fp)
+  move $s0, $a0
+  li $t9, 1
+  beq $s0, $t9, label1
+  j label2
+label1:
+  move $v0, $s0
+  lw $s0, -12($fp)
+  move $sp, $fp
+  lw $ra, -4($fp)
+  lw $fp, -8($fp)
+  jr $ra
+  j label3
+label2:
+  addi $t0, $s0, -1
+  move $a0, $t0
+  jal f_fact
+  move $t0, $v0
+  mul $t0, $s0, $t0
+  move $v0, $t0
+  lw $s0, -12($fp)
+  move $sp, $fp
+  lw $ra, -4($fp)
+  lw $fp, -8($fp)
+  jr $ra
+label3:
+  move $v0, $zero
+  lw $s0, -12($fp)
+  move $sp, $fp
+  lw $ra, -4($fp)
+  lw $fp, -8($fp)
+  jr $ra
+
+main:
+  sw $ra, -4($sp)
+  sw $fp, -8($sp)
+  move $fp, $sp
+  addi $sp, $sp, -8
+  jal read
+  move $t0, $v0
+  li $t9, 1
+  bgt $t0, $t9, label4
+  j label5
+label4:
+  move $a0, $t0
+  jal f_fact
+  move $t0, $v0
+  j label6
+label5:
+  li $t0, 1
+label6:
+  move $a0, $t0
+  jal write
+  move $v0, $zero
+  move $sp, $fp
+  lw $ra, -4($fp)
+  lw $fp, -8($fp)
+  jr $ra
@@ -0,0 +1,63 @@
+.data
+_prompt: .asciiz "Enter an integer:"
+_ret: .asciiz "\n"
+.globl main
+.text
+read:
+  li $v0, 4
+  la $a0, _prompt
+  syscall
+  li $v0, 5
+  syscall
+  jr $ra
+
+write:
+  li $v0, 1
+  syscall
+  li $v0, 4
+  la $a0, _ret
+  syscall
+  move $v0, $0
+  jr $ra
+
+f_add:
+  sw $ra, -4($sp)
+  sw $fp, -8($sp)
+  move $fp, $sp
+  addi $sp, $sp, -8
+  move $t0, $a0
+  addi $t1, $t0, 0
+  addi $t0, $t0, 4
+  lw $t1, 0($t1)
+  lw $t0, 0($t0)
+  add $t0, $t1, $t0
+  move $v0, $t0
+  move $sp, $fp
+  lw $ra, -4($fp)
+  lw $fp, -8($fp)
+  jr $ra
+
+main:
+  sw $ra, -4($sp)
+  sw $fp, -8($sp)
+  move $fp, $sp
+  addi $sp, $sp, -16
+  addi $t0, $fp, -16
+  addi $t0, $t0, 0
+  li $t9, 1
+  sw $t9, 0($t0)
+  addi $t0, $fp, -16
+  addi $t0, $t0, 4
+  li $t9, 2
+  sw $t9, 0($t0)
+  addi $t0, $fp, -16
+  move $a0, $t0
+  jal f_add
+  move $t0, $v0
+  move $a0, $t0
+  jal write
+  move $v0, $zero
+  move $sp, $fp
+  lw $ra, -4($fp)
+  lw $fp, -8($fp)
+  jr $ra
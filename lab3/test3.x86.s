@@ -0,0 +1,117 @@
+    .local cmm_memory
+    .comm cmm_memory, 67108864, 16
+cmm_read:
+    pushq %rbp
+    movq %rsp, %rbp
+    pushq %rcx
+    pushq %rsi
+    pushq %rdi
+    pushq %r8
+    pushq %r9
+    pushq %r10
+    subq $8, %rsp
+    andq $-16, %rsp
+    movl $0, (%rsp)
+    movq %rsp, %rsi
+    leaq .Lcmm_in(%rip), %rdi
+    xorl %eax, %eax
+    call scanf@PLT
+    movl (%rsp), %eax
+    leaq -48(%rbp), %rsp
+    popq %r10
+    popq %r9
+    popq %r8
+    popq %rdi
+    popq %rsi
+    popq %rcx
+    popq %rbp
+    ret
+
+cmm_write:
+    pushq %rbp
+    movq %rsp, %rbp
+    pushq %rcx
+    pushq %rsi
+    pushq %rdi
+    pushq %r8
+    pushq %r9
+    pushq %r10
+    andq $-16, %rsp
+    movl %eax, %esi
+    leaq .Lcmm_out(%rip), %rdi
+    xorl %eax, %eax
+    call printf@PLT
+    leaq -48(%rbp), %rsp
+    popq %r10
+    popq %r9
+    popq %r8
+    popq %rdi
+    popq %rsi
+    popq %rcx
+    popq %rbp
+    ret
+
+    .section .rodata
+.Lcmm_in:
+    .string "%d"
+.Lcmm_out:
+    .string "%d\n"
+    .section .note.GNU-stack, "", @progbits
+    .text
+    .globl main
+main:
+    pushq %rbp
+    movq %rsp, %rbp
+    pushq %r14
+    pushq %r15
+    leaq cmm_memory(%rip), %r15
+    movl $67108864, %r14d
+    call cmm_main
+    popq %r15
+    popq %r14
+    popq %rbp
+    ret
+
+cmm_add:
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $16, %rsp
+    movq %rbx, -8(%rbp)
+    movq %rcx, -16(%rbp)
+    movl 16(%rbp), %ebx
+    movl %ebx, %ecx
+    addl $0, %ecx
+    addl $4, %ebx
+    movl (%r15,%rcx), %ecx
+    movl (%r15,%rbx), %ebx
+    addl %ecx, %ebx
+    movl %ebx, %eax
+    movq -8(%rbp), %rbx
+    movq -16(%rbp), %rcx
+    leave
+    ret
+
+cmm_main:
+    pushq %rbp
+    movq %rsp, %rbp
+    subq $8, %rsp
+    movq %rbx, -8(%rbp)
+    subl $8, %r14d
+    leal 0(%r14), %ebx
+    addl $0, %ebx
+    movl $1, (%r15,%rbx)
+    leal 0(%r14), %ebx
+    addl $4, %ebx
+    movl $2, (%r15,%rbx)
+    leal 0(%r14), %ebx
+    pushq %rbx
+    call cmm_add
+    addq $8, %rsp
+    movl %eax, %ebx
+    movl %ebx, %eax
+    call cmm_write
+    movl $0, %eax
+    addl $8, %r14d
+    movq -8(%rbp), %rbx
+    leave
+    ret
@@ -0,0 +1,644 @@
+#include "x86.h"
+
+static const char* regs32[X86_REG_NUM] = {"%ebx", "%ecx", "%esi", "%edi", "%r8d", "%r9d", "%r10d", "%r12d", "%r13d"};
+static const char* regs64[X86_REG_NUM] = {"%rbx", "%rcx", "%rsi", "%rdi", "%r8", "%r9", "%r10", "%r12", "%r13"};
+
+// C-- functions are cmm_ prefixed and take their arguments on the stack. They save every
+// allocatable register they use, so a call clobbers only %eax, %edx and %r11d. main sets up
+// %r15 as the base of C-- memory and %r14 as the offset of its stack top, C-- addresses are
+// 32 bit offsets from %r15 like the interpreter's. READ and WRITE wrap scanf and printf, keep
+// the allocatable registers SysV lets them clobber and align the stack for libc.
+static const char* runtime =
+    "cmm_read:\n"
+    "    pushq %rbp\n"
+    "    movq %rsp, %rbp\n"
+    "    pushq %rcx\n"
+    "    pushq %rsi\n"
+    "    pushq %rdi\n"
+    "    pushq %r8\n"
+    "    pushq %r9\n"
+    "    pushq %r10\n"
+    "    subq $8, %rsp\n"
+    "    andq $-16, %rsp\n"
+    "    movl $0, (%rsp)\n"
+    "    movq %rsp, %rsi\n"
+    "    leaq .Lcmm_in(%rip), %rdi\n"
+    "    xorl %eax, %eax\n"
+    "    call scanf@PLT\n"
+    "    movl (%rsp), %eax\n"
+    "    leaq -48(%rbp), %rsp\n"
+    "    popq %r10\n"
+    "    popq %r9\n"
+    "    popq %r8\n"
+    "    popq %rdi\n"
+    "    popq %rsi\n"
+    "    popq %rcx\n"
+    "    popq %rbp\n"
+    "    ret\n"
+    "\n"
+    "cmm_write:\n"
+    "    pushq %rbp\n"
+    "    movq %rsp, %rbp\n"
+    "    pushq %rcx\n"
+    "    pushq %rsi\n"
+    "    pushq %rdi\n"
+    "    pushq %r8\n"
+    "    pushq %r9\n"
+    "    pushq %r10\n"
+    "    andq $-16, %rsp\n"
+    "    movl %eax, %esi\n"
+    "    leaq .Lcmm_out(%rip), %rdi\n"
+    "    xorl %eax, %eax\n"
+    "    call printf@PLT\n"
+    "    leaq -48(%rbp), %rsp\n"
+    "    popq %r10\n"
+    "    popq %r9\n"
+    "    popq %r8\n"
+    "    popq %rdi\n"
+    "    popq %rsi\n"
+    "    popq %rcx\n"
+    "    popq %rbp\n"
+    "    ret\n"
+    "\n"
+    "    .section .rodata\n"
+    ".Lcmm_in:\n"
+    "    .string \"%d\"\n"
+    ".Lcmm_out:\n"
+    "    .string \"%d\\n\"\n"
+    "    .section .note.GNU-stack, \"\", @progbits\n"
+    "    .text\n";
+
+// register allocation of one function, nodes are the variables the function mentions
+typedef struct x86Func {
+    pInterCodeList list;
+    pCfg cfg;
+    pLiveness live;
+    int* nodeOf;        // per key, -1 if the key is no node, reset after the function
+    int* keys;          // key of a node
+    int nodeNum;
+    int* reg;           // -1 for nodes living in memory
+    int* offset;        // %rbp offset of a spilled node, %r14 offset of one in C-- memory
+    int* size;          // bytes of DEC storage, 0 for scalars
+    boolean* inMemory;  // DEC storage and variables whose address is taken live in C-- memory
+    int* start;         // live interval, code i is read at 2i and written at 2i + 1
+    int* end;
+    int savedMask;
+    int frameSize;      // stack bytes below %rbp
+    int memorySize;     // C-- memory bytes
+} X86Func;
+
+static void addNode(X86Func* f, int index) {
+    int key = getVarKey(f->list, index);
+    if (key < 0 || f->nodeOf[key] >= 0) return;
+    f->nodeOf[key] = f->nodeNum;
+    f->keys[f->nodeNum++] = key;
+}
+
+static int getNode(X86Func* f, int index) {
+    int key = getVarKey(f->list, index);
+    return key < 0 ? -1 : f->nodeOf[key];
+}
+
+static void touch(X86Func* f, int v, int point) {
+    if (point < f->start[v]) f->start[v] = point;
+    if (point > f->end[v]) f->end[v] = point;
+}
+
+static X86Func* sortFunc;
+
+static int compareStart(const void* a, const void* b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    if (sortFunc->start[x] != sortFunc->start[y]) return sortFunc->start[x] < sortFunc->start[y] ? -1 : 1;
+    return x < y ? -1 : x > y;
+}
+
+// Every variable gets one interval from its first to its last live point. Intervals are taken
+// by start, a full register file gives the register of the active interval ending last to the
+// new one if that one ends sooner, and the other is spilled.
+static void scanIntervals(X86Func* f) {
+    int n = f->nodeNum, activeNum = 0;
+    int* order = (int*)malloc(sizeof(int) * (n + 1));
+    int active[X86_REG_NUM];
+    assert(order != NULL);
+    int orderNum = 0;
+    for (int v = 0; v < n; v++) {
+        f->reg[v] = -1;
+        if (!f->inMemory[v] && f->start[v] <= f->end[v]) order[orderNum++] = v;
+    }
+    sortFunc = f;
+    qsort(order, orderNum, sizeof(int), compareStart);
+
+    unsigned freeRegs = (1u << X86_REG_NUM) - 1;
+    for (int k = 0; k < orderNum; k++) {
+        int v = order[k];
+        // active is sorted by end, expire the intervals over before v starts
+        int j = 0;
+        while (j < activeNum && f->end[active[j]] < f->start[v])
+            freeRegs |= 1u << f->reg[active[j++]];
+        memmove(active, active + j, sizeof(int) * (activeNum - j));
+        activeNum -= j;
+
+        int victim = v;
+        if (freeRegs != 0) {
+            int r = __builtin_ctz(freeRegs);
+            freeRegs &= ~(1u << r);
+            f->reg[v] = r;
+        }
+        else if (f->end[active[activeNum - 1]] > f->end[v]) {
+            victim = active[--activeNum];
+            f->reg[v] = f->reg[victim];
+            f->reg[victim] = -1;
+        }
+        if (f->reg[v] < 0) continue;
+        int pos = activeNum++;
+        while (pos > 0 && f->end[active[pos - 1]] > f->end[v]) {
+            active[pos] = active[pos - 1];
+            pos--;
+        }
+        active[pos] = v;
+        f->savedMask |= 1 << f->reg[v];
+    }
+    free(order);
+}
+
+static void allocateRegisters(X86Func* f, pX86Stat stat) {
+    pInterCodeList interCodeList = f->list;
+    pCfg p = f->cfg;
+    pInterCode codes = interCodeList->codes;
+    f->nodeNum = 0;
+    for (int i = p->first; i < p->last; i++) {
+        pInterCode cur = &codes[i];
+        addNode(f, getCodeDef(cur));
+        int* uses[3];
+        int useNum = getCodeUses(cur, uses);
+        for (int j = 0; j < useNum; j++)
+            addNode(f, *uses[j]);
+        if (cur->kind == IR_DEC) addNode(f, cur->u.dec.op);
+        if (cur->kind == IR_GET_ADDR) addNode(f, cur->u.assign.right);
+    }
+
+    int n = f->nodeNum;
+    f->reg = (int*)malloc(sizeof(int) * (n + 1));
+    f->offset = (int*)calloc(n + 1, sizeof(int));
+    f->size = (int*)calloc(n + 1, sizeof(int));
+    f->inMemory = (boolean*)calloc(n + 1, sizeof(boolean));
+    f->start = (int*)malloc(sizeof(int) * (n + 1));
+    f->end = (int*)malloc(sizeof(int) * (n + 1));
+    assert(f->reg != NULL && f->offset != NULL && f->size != NULL && f->inMemory != NULL && f->start != NULL &&
+           f->end != NULL);
+    for (int v = 0; v < n; v++) {
+        f->start[v] = 0x7fffffff;
+        f->end[v] = -1;
+    }
+    for (int i = p->first; i < p->last; i++) {
+        if (codes[i].kind == IR_DEC) {
+            int v = getNode(f, codes[i].u.dec.op);
+            f->inMemory[v] = TRUE;
+            f->size[v] = codes[i].u.dec.size;
+        }
+        if (codes[i].kind == IR_GET_ADDR) f->inMemory[getNode(f, codes[i].u.assign.right)] = TRUE;
+    }
+
+    // interval hulls, walking each block backwards from its live out set
+    int* dense = (int*)malloc(sizeof(int) * (n + 1));
+    int* pos = (int*)malloc(sizeof(int) * (n + 1));
+    assert(dense != NULL && pos != NULL);
+    for (int v = 0; v < n; v++)
+        pos[v] = -1;
+    for (int b = 0; b < p->blockNum; b++) {
+        int liveNum = 0, first = 2 * (p->blocks[b].first - p->first);
+        for (int k = 0; k < f->live->globalNum; k++) {
+            int key = f->live->globals[k];
+            int v = f->nodeOf[key];
+            if (v >= 0 && !f->inMemory[v] && isLiveOut(f->live, b, key)) {
+                touch(f, v, 2 * (p->blocks[b].last - 1 - p->first) + 1);
+                pos[v] = liveNum;
+                dense[liveNum++] = v;
+            }
+        }
+        for (int i = p->blocks[b].last - 1; i >= p->blocks[b].first; i--) {
+            int point = 2 * (i - p->first);
+            int d = getNode(f, getCodeDef(&codes[i]));
+            if (d >= 0 && !f->inMemory[d]) {
+                touch(f, d, point + 1);
+                if (pos[d] >= 0) {
+                    int last = dense[--liveNum];
+                    dense[pos[d]] = last;
+                    pos[last] = pos[d];
+                    pos[d] = -1;
+                }
+            }
+            int* uses;
+            int useNum = getLiveUses(f->live, i, &uses);
+            for (int j = 0; j < useNum; j++) {
+                int v = f->nodeOf[uses[j]];
+                if (f->inMemory[v]) continue;
+                touch(f, v, point);
+                if (pos[v] < 0) {
+                    pos[v] = liveNum;
+                    dense[liveNum++] = v;
+                }
+            }
+        }
+        for (int j = 0; j < liveNum; j++) {
+            touch(f, dense[j], first);
+            pos[dense[j]] = -1;
+        }
+    }
+    free(dense);
+    free(pos);
+
+    f->savedMask = 0;
+    scanIntervals(f);
+
+    // saved registers, then spill slots below %rbp, spilled PARAMs keep the slot they came in
+    int top = 0;
+    for (int r = 0; r < X86_REG_NUM; r++)
+        if (f->savedMask >> r & 1) top += 8;
+    int paramNum = 0;
+    for (int i = p->first; i < p->last; i++)
+        if (codes[i].kind == IR_PARAM) {
+            int v = getNode(f, codes[i].u.oneOp.op);
+            f->offset[v] = 16 + 8 * paramNum++;
+        }
+    for (int v = 0; v < n; v++)
+        if (!f->inMemory[v] && f->reg[v] < 0 && f->offset[v] == 0) {
+            top += 8;
+            f->offset[v] = -top;
+        }
+    f->frameSize = top;
+    f->memorySize = 0;
+    for (int v = 0; v < n; v++)
+        if (f->inMemory[v]) {
+            f->offset[v] = f->memorySize;
+            f->memorySize += f->size[v] > 0 ? (f->size[v] + 3) & ~3 : 4;
+        }
+
+    stat->funcNum++;
+    for (int v = 0; v < n; v++) {
+        if (f->inMemory[v]) continue;
+        stat->varNum++;
+        if (f->reg[v] < 0) stat->spillNum++;
+    }
+}
+
+static void freeAllocation(X86Func* f) {
+    for (int v = 0; v < f->nodeNum; v++)
+        f->nodeOf[f->keys[v]] = -1;
+    free(f->reg);
+    free(f->offset);
+    free(f->size);
+    free(f->inMemory);
+    free(f->start);
+    free(f->end);
+}
+
+// emit func
+// one line of assembly, fmt knows %s, %d and %l for a label operand
+static void emitAsm(pOutBuffer out, const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    putString(out, "    ");
+    for (; *fmt; fmt++) {
+        if (*fmt != '%') {
+            putChar(out, *fmt);
+            continue;
+        }
+        fmt++;
+        if (*fmt == 's')
+            putString(out, va_arg(args, const char*));
+        else if (*fmt == 'l')
+            printOp(out, va_arg(args, pOperand));
+        else if (*fmt == '%')
+            putChar(out, '%');
+        else {
+            assert(*fmt == 'd');
+            putInt(out, va_arg(args, int));
+        }
+    }
+    putChar(out, '\n');
+    va_end(args);
+}
+
+// AT&T text of an operand: $c, a register, a stack slot or a slot of C-- memory
+static const char* getText(X86Func* f, int index, char* buf) {
+    pOperand op = getOperand(f->list, index);
+    if (op->kind == OP_CONSTANT) {
+        sprintf(buf, "$%d", op->u.value);
+        return buf;
+    }
+    int v = getNode(f, index);
+    assert(v >= 0 && f->size[v] == 0);
+    if (f->inMemory[v])
+        sprintf(buf, "%d(%%r15,%%r14)", f->offset[v]);
+    else if (f->reg[v] >= 0)
+        return regs32[f->reg[v]];
+    else
+        sprintf(buf, "%d(%%rbp)", f->offset[v]);
+    return buf;
+}
+
+static boolean inRegister(X86Func* f, int index) {
+    int v = getNode(f, index);
+    return v >= 0 && !f->inMemory[v] && f->reg[v] >= 0;
+}
+
+static boolean isConstantOp(X86Func* f, int index) {
+    return getOperand(f->list, index)->kind == OP_CONSTANT;
+}
+
+// a result may take the register of an operand dying at the same code
+static boolean sameRegister(X86Func* f, int a, int b) {
+    return inRegister(f, a) && inRegister(f, b) && f->reg[getNode(f, a)] == f->reg[getNode(f, b)];
+}
+
+// movl from to, through %eax when both are in memory
+static void emitMove(pOutBuffer out, X86Func* f, int to, int from) {
+    char a[32], b[32];
+    const char* source = getText(f, from, a);
+    const char* target = getText(f, to, b);
+    if (!strcmp(source, target)) return;
+    if (!inRegister(f, to) && !inRegister(f, from) && !isConstantOp(f, from)) {
+        emitAsm(out, "movl %s, %%eax", source);
+        emitAsm(out, "movl %%eax, %s", target);
+    }
+    else
+        emitAsm(out, "movl %s, %s", source, target);
+}
+
+static void emitFuncLabel(pOutBuffer out, pOperand func) {
+    putString(out, "cmm_");
+    putString(out, func->u.name);
+}
+
+// the (%r15,...) operand at the C-- address held by index
+static const char* getAddress(pOutBuffer out, X86Func* f, int index, char* buf) {
+    char a[32];
+    if (inRegister(f, index))
+        sprintf(buf, "(%%r15,%s)", regs64[f->reg[getNode(f, index)]]);
+    else {
+        emitAsm(out, "movl %s, %%eax", getText(f, index, a));
+        strcpy(buf, "(%r15,%rax)");
+    }
+    return buf;
+}
+
+static void emitBinOp(pOutBuffer out, X86Func* f, pInterCode code) {
+    static const char* ops[] = {[IR_ADD] = "addl", [IR_SUB] = "subl", [IR_MUL] = "imull"};
+    int d = code->u.binOp.result, x = code->u.binOp.op1, y = code->u.binOp.op2;
+    char a[32], b[32], c[32];
+    if (code->kind == IR_DIV) {
+        // INT_MIN / -1 wraps like the interpreter instead of trapping
+        emitAsm(out, "movl %s, %%eax", getText(f, x, a));
+        if (isConstantOp(f, y) && getOperand(f->list, y)->u.value == -1)
+            emitAsm(out, "negl %%eax");
+        else if (isConstantOp(f, y)) {
+            emitAsm(out, "movl %s, %%r11d", getText(f, y, b));
+            emitAsm(out, "cltd");
+            emitAsm(out, "idivl %%r11d");
+        }
+        else {
+            const char* divisor = getText(f, y, b);
+            emitAsm(out, "cmpl $-1, %s", divisor);
+            emitAsm(out, "je 1f");
+            emitAsm(out, "cltd");
+            emitAsm(out, "idivl %s", divisor);
+            emitAsm(out, "jmp 2f");
+            putString(out, "1:\n");
+            emitAsm(out, "negl %%eax");
+            putString(out, "2:\n");
+        }
+        emitAsm(out, "movl %%eax, %s", getText(f, d, c));
+        return;
+    }
+    const char* op = ops[code->kind];
+    if (inRegister(f, d) && !sameRegister(f, d, y)) {
+        emitMove(out, f, d, x);
+        emitAsm(out, "%s %s, %s", op, getText(f, y, b), getText(f, d, c));
+    }
+    else if (inRegister(f, d) && code->kind != IR_SUB)
+        emitAsm(out, "%s %s, %s", op, getText(f, x, a), getText(f, d, c));
+    else {
+        emitAsm(out, "movl %s, %%eax", getText(f, x, a));
+        emitAsm(out, "%s %s, %%eax", op, getText(f, y, b));
+        emitAsm(out, "movl %%eax, %s", getText(f, d, c));
+    }
+}
+
+static void emitPrologue(pOutBuffer out, X86Func* f) {
+    emitAsm(out, "pushq %%rbp");
+    emitAsm(out, "movq %%rsp, %%rbp");
+    if (f->frameSize > 0) emitAsm(out, "subq $%d, %%rsp", f->frameSize);
+    for (int r = 0, offset = -8; r < X86_REG_NUM; r++)
+        if (f->savedMask >> r & 1) {
+            emitAsm(out, "movq %s, %d(%%rbp)", regs64[r], offset);
+            offset -= 8;
+        }
+    if (f->memorySize > 0) emitAsm(out, "subl $%d, %%r14d", f->memorySize);
+}
+
+static void emitEpilogue(pOutBuffer out, X86Func* f) {
+    if (f->memorySize > 0) emitAsm(out, "addl $%d, %%r14d", f->memorySize);
+    for (int r = 0, offset = -8; r < X86_REG_NUM; r++)
+        if (f->savedMask >> r & 1) {
+            emitAsm(out, "movq %d(%%rbp), %s", offset, regs64[r]);
+            offset -= 8;
+        }
+    emitAsm(out, "leave");
+    emitAsm(out, "ret");
+}
+
+static void emitCall(pOutBuffer out, X86Func* f, int i) {
+    pInterCode codes = f->list->codes;
+    char a[32];
+    // the ARGs since the previous CALL, pushed so that the first parameter ends up at 16(%rbp)
+    int first = i, argNum = 0;
+    while (first > f->cfg->first && codes[first - 1].kind != IR_CALL && codes[first - 1].kind != IR_LABEL &&
+           codes[first - 1].kind != IR_FUNCTION)
+        first--;
+    for (int j = first; j < i; j++) {
+        if (codes[j].kind != IR_ARG) continue;
+        int op = codes[j].u.oneOp.op, v = getNode(f, op);
+        argNum++;
+        if (isConstantOp(f, op))
+            emitAsm(out, "pushq %s", getText(f, op, a));
+        else if (f->inMemory[v]) {
+            emitAsm(out, "movl %s, %%eax", getText(f, op, a));
+            emitAsm(out, "pushq %%rax");
+        }
+        else if (f->reg[v] >= 0)
+            emitAsm(out, "pushq %s", regs64[f->reg[v]]);
+        else
+            emitAsm(out, "pushq %d(%%rbp)", f->offset[v]);
+    }
+    putString(out, "    call ");
+    emitFuncLabel(out, getOperand(f->list, codes[i].u.assign.right));
+    putChar(out, '\n');
+    if (argNum > 0) emitAsm(out, "addq $%d, %%rsp", 8 * argNum);
+    emitAsm(out, "movl %%eax, %s", getText(f, codes[i].u.assign.left, a));
+}
+
+static void emitFunction(pOutBuffer out, X86Func* f) {
+    pInterCodeList interCodeList = f->list;
+    pInterCode codes = interCodeList->codes;
+    static const char* relops[][2] = {{"==", "je"}, {"!=", "jne"}, {"<", "jl"}, {">", "jg"}, {"<=", "jle"}, {">=", "jge"}};
+    char a[32], b[32];
+
+    for (int i = f->cfg->first; i < f->cfg->last; i++) {
+        pInterCode cur = &codes[i];
+        switch (cur->kind) {
+            case IR_FUNCTION:
+                putChar(out, '\n');
+                emitFuncLabel(out, getOperand(interCodeList, cur->u.oneOp.op));
+                putString(out, ":\n");
+                emitPrologue(out, f);
+                break;
+            case IR_PARAM: {
+                // registers and C-- memory get the PARAM from its stack slot
+                int v = getNode(f, cur->u.oneOp.op);
+                if (f->inMemory[v]) {
+                    int slot = 16;
+                    for (int j = f->cfg->first; j < i; j++)
+                        if (codes[j].kind == IR_PARAM) slot += 8;
+                    emitAsm(out, "movl %d(%%rbp), %%eax", slot);
+                    emitAsm(out, "movl %%eax, %s", getText(f, cur->u.oneOp.op, a));
+                }
+                else if (f->reg[v] >= 0)
+                    emitAsm(out, "movl %d(%%rbp), %s", f->offset[v], regs32[f->reg[v]]);
+                break;
+            }
+            case IR_LABEL:
+                printOp(out, getOperand(interCodeList, cur->u.oneOp.op));
+                putString(out, ":\n");
+                break;
+            case IR_ASSIGN:
+                emitMove(out, f, cur->u.assign.left, cur->u.assign.right);
+                break;
+            case IR_ADD:
+            case IR_SUB:
+            case IR_MUL:
+            case IR_DIV:
+                emitBinOp(out, f, cur);
+                break;
+            case IR_GET_ADDR: {
+                int v = getNode(f, cur->u.assign.right);
+                if (inRegister(f, cur->u.assign.left))
+                    emitAsm(out, "leal %d(%%r14), %s", f->offset[v], getText(f, cur->u.assign.left, a));
+                else {
+                    emitAsm(out, "leal %d(%%r14), %%eax", f->offset[v]);
+                    emitAsm(out, "movl %%eax, %s", getText(f, cur->u.assign.left, a));
+                }
+                break;
+            }
+            case IR_READ_ADDR:
+                getAddress(out, f, cur->u.assign.right, b);
+                if (inRegister(f, cur->u.assign.left))
+                    emitAsm(out, "movl %s, %s", b, getText(f, cur->u.assign.left, a));
+                else {
+                    emitAsm(out, "movl %s, %%eax", b);
+                    emitAsm(out, "movl %%eax, %s", getText(f, cur->u.assign.left, a));
+                }
+                break;
+            case IR_WRITE_ADDR:
+                getAddress(out, f, cur->u.assign.left, b);
+                if (inRegister(f, cur->u.assign.right) || isConstantOp(f, cur->u.assign.right))
+                    emitAsm(out, "movl %s, %s", getText(f, cur->u.assign.right, a), b);
+                else {
+                    emitAsm(out, "movl %s, %%edx", getText(f, cur->u.assign.right, a));
+                    emitAsm(out, "movl %%edx, %s", b);
+                }
+                break;
+            case IR_GOTO:
+                emitAsm(out, "jmp %l", getOperand(interCodeList, cur->u.oneOp.op));
+                break;
+            case IR_IF_GOTO: {
+                char* relop = getOperand(interCodeList, cur->u.ifGoto.relop)->u.name;
+                int x = cur->u.ifGoto.x, y = cur->u.ifGoto.y;
+                const char* left = getText(f, x, a);
+                if (isConstantOp(f, x) || (!inRegister(f, x) && !inRegister(f, y) && !isConstantOp(f, y))) {
+                    emitAsm(out, "movl %s, %%eax", left);
+                    left = "%eax";
+                }
+                emitAsm(out, "cmpl %s, %s", getText(f, y, b), left);
+                for (int k = 0; k < 6; k++)
+                    if (!strcmp(relops[k][0], relop))
+                        emitAsm(out, "%s %l", relops[k][1], getOperand(interCodeList, cur->u.ifGoto.z));
+                break;
+            }
+            case IR_RETURN:
+                emitAsm(out, "movl %s, %%eax", getText(f, cur->u.oneOp.op, a));
+                emitEpilogue(out, f);
+                break;
+            case IR_CALL:
+                emitCall(out, f, i);
+                break;
+            case IR_READ:
+                emitAsm(out, "call cmm_read");
+                emitAsm(out, "movl %%eax, %s", getText(f, cur->u.oneOp.op, a));
+                break;
+            case IR_WRITE:
+                emitAsm(out, "movl %s, %%eax", getText(f, cur->u.oneOp.op, a));
+                emitAsm(out, "call cmm_write");
+                break;
+            default:
+                // DEC has its storage in C-- memory, ARGs are pushed by their CALL
+                break;
+        }
+    }
+    // falling off the end returns 0 like the interpreter
+    if (codes[f->cfg->last - 1].kind != IR_RETURN) {
+        emitAsm(out, "xorl %%eax, %%eax");
+        emitEpilogue(out, f);
+    }
+}
+
+void emitX86(pOutBuffer out, pInterCodeList interCodeList, pX86Stat stat) {
+    assert(out != NULL && interCodeList != NULL && stat != NULL);
+    *stat = (X86Stat){0, 0, 0};
+    X86Func f = {.list = interCodeList, .live = newLiveness(interCodeList)};
+    f.nodeOf = (int*)malloc(sizeof(int) * f.live->keyNum);
+    f.keys = (int*)malloc(sizeof(int) * f.live->keyNum);
+    assert(f.nodeOf != NULL && f.keys != NULL);
+    for (int i = 0; i < f.live->keyNum; i++)
+        f.nodeOf[i] = -1;
+
+    emitAsm(out, ".local cmm_memory");
+    emitAsm(out, ".comm cmm_memory, %d, 16", X86_MEMORY_SIZE);
+    putString(out, runtime);
+    putString(out, "    .globl main\nmain:\n");
+    emitAsm(out, "pushq %%rbp");
+    emitAsm(out, "movq %%rsp, %%rbp");
+    emitAsm(out, "pushq %%r14");
+    emitAsm(out, "pushq %%r15");
+    emitAsm(out, "leaq cmm_memory(%%rip), %%r15");
+    emitAsm(out, "movl $%d, %%r14d", X86_MEMORY_SIZE);
+    emitAsm(out, "call cmm_main");
+    emitAsm(out, "popq %%r15");
+    emitAsm(out, "popq %%r14");
+    emitAsm(out, "popq %%rbp");
+    emitAsm(out, "ret");
+    for (int first = 0; first < interCodeList->count; ) {
+        int last = getFunctionEnd(interCodeList, first);
+        if (interCodeList->codes[first].kind != IR_FUNCTION) {
+            first = last;
+            continue;
+        }
+        f.cfg = newCfg(interCodeList, first, last);
+        computeLiveness(f.live, f.cfg);
+        allocateRegisters(&f, stat);
+        emitFunction(out, &f);
+        freeAllocation(&f);
+        deleteCfg(f.cfg);
+        first = last;
+    }
+
+    free(f.nodeOf);
+    free(f.keys);
+    deleteLiveness(f.live);
+}
+
+void printX86(FILE* fp, pInterCodeList interCodeList, pX86Stat stat) {
+    pOutBuffer out = newOutBuffer(fp == NULL ? stdout : fp);
+    emitX86(out, interCodeList, stat);
+    deleteOutBuffer(out);
+}
@@ -0,0 +1,20 @@
+#ifndef X86_H
+#define X86_H
+#include "cfg.h"
+
+#define X86_REG_NUM 9           // allocatable, %eax %edx %r11d are scratch, %r14 %r15 address memory
+#define X86_MEMORY_SIZE 0x4000000   // bytes of C-- memory for DEC storage and address taken variables
+
+typedef struct x86Stat* pX86Stat;
+
+typedef struct x86Stat {
+    int funcNum;
+    int varNum;         // variables competing for registers
+    int spillNum;       // of them left in the stack frame
+} X86Stat;
+
+// emit func
+void emitX86(pOutBuffer out, pInterCodeList interCodeList, pX86Stat stat);
+void printX86(FILE* fp, pInterCodeList interCodeList, pX86Stat stat);
+
+#endif